@@ -14,6 +14,35 @@ void UNavigationAgentComponent::BeginPlay()
 	Super::BeginPlay();
 
 	InitializeAgent();
+	if (NavigationMesh)
+		NavigationMesh->AddTileStreamingSource(GetOwner());		//	Keep the tiles around the Agent loaded
+	if (UseAgentSubsystem)
+		if (UNavigationAgentSubsystem* _agentSubsystem = GetWorld()->GetSubsystem<UNavigationAgentSubsystem>())
+		{
+			_agentSubsystem->RegisterAgent(this);
+			SetComponentTickEnabled(false);
+		}
+	if (LODMode != ENavigationAgentLODMode::AgentLODNone)		//	Random first delay : Agents spawned together don't update on the same frame
+		GetWorld()->GetTimerManager().SetTimer(LODTimerHandle, this, &UNavigationAgentComponent::UpdateAgentLOD, LODUpdateInterval, true, FMath::FRand() * LODUpdateInterval);
+}
+void UNavigationAgentComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (NavigationMesh)
+		NavigationMesh->RemoveTileStreamingSource(GetOwner());
+	CancelPathQuery();
+	FlowField = nullptr;
+	Replanner = nullptr;
+	if (SimulationSlot != INDEX_NONE)
+		if (UNavigationAgentSubsystem* _agentSubsystem = GetWorld()->GetSubsystem<UNavigationAgentSubsystem>())
+			_agentSubsystem->UnregisterAgent(this);
+	GetWorld()->GetTimerManager().ClearTimer(LODTimerHandle);
+	if (IsSteeringHeld)
+		if (UNavigationAgentSubsystem* _agentSubsystem = GetWorld()->GetSubsystem<UNavigationAgentSubsystem>())
+			_agentSubsystem->ReleaseAgentSteering(this);
+	IsSteeringHeld = false;
+	CancelRecompute();
+
+	Super::EndPlay(EndPlayReason);
 }
 void UNavigationAgentComponent::TickComponent(float DeltaTime, ELevelTick TickType,	FActorComponentTickFunction* ThisTickFunction)
 {
@@ -28,8 +57,9 @@ void UNavigationAgentComponent::MoveToLocation(const FVector& _worldLocation)
 
 	TargetActor = nullptr;
 	TargetLocation = _worldLocation;
+	FlowField = nullptr;
 
-	NavigationAlgorithm->ComputePath(NavigationMesh->GetClosestNode(AgentLocation()), NavigationMesh->GetClosestNode(TargetLocation));
+	RequestPath(NavigationMesh->GetClosestNodeIndex(AgentLocation()), TargetLocation);
 }
 void UNavigationAgentComponent::MoveToActor(AActor* _actor)
 {
@@ -38,7 +68,13 @@ void UNavigationAgentComponent::MoveToActor(AActor* _actor)
 	TargetActor = _actor;
 	TargetLocation = FVector::ZeroVector;
 
-	NavigationAlgorithm->ComputePath(NavigationMesh->GetClosestNode(AgentLocation()), NavigationMesh->GetClosestNode(TargetActor->GetActorLocation()));
+	if (UseFlowField)
+	{
+		FollowFlowField(NavigationMesh->GetClosestNodeIndex(AgentLocation()), NavigationMesh->GetClosestNodeIndex(TargetActor->GetActorLocation()));
+		return;
+	}
+	FlowField = nullptr;
+	RequestPath(NavigationMesh->GetClosestNodeIndex(AgentLocation()), TargetActor->GetActorLocation());
 }
 
 void UNavigationAgentComponent::ResumeAgent()
@@ -81,13 +117,23 @@ void UNavigationAgentComponent::TickAgent(const float _deltaTime)
 	
 	if (IsFollowingPath && !FollowPath.PathCompleted)
 	{
+		SteeringTimer += _deltaTime;
+		if (SteeringTimer < GetUpdateInterval() && SteeringNode == FollowPath.CurrentNode)	//	Coarse LOD : last direction kept until the next update
+		{
+			if (MovementEnable && !IsSteeringHeld)
+				OwnerPawn->AddMovementInput(SteeringDirection);
+			return;
+		}
+		const float _steeringTime = SteeringTimer;
+		SteeringTimer = 0;
+
 		FVector _location = AgentLocation();
-		FVector _nodeLocation = FollowPath.CurrentNode->NodeLocation();
+		FVector _nodeLocation = FollowPath.CurrentNodeLocation();
 		_location.Z = 0;
 		_nodeLocation.Z = 0;
 	
-		UpdateAgentMovement(_deltaTime);
-		UpdateAgentRotation(_deltaTime);
+		UpdateAgentMovement(_steeringTime);
+		UpdateAgentRotation(_steeringTime);
 	}
 }
 
@@ -96,9 +142,11 @@ void UNavigationAgentComponent::UpdateAgentMovement(const float _deltaTime)
 	if (!MovementEnable || !IsFollowingPath || !OwnerPawn) return;
 
 	const FVector& _agentLocation = AgentLocation();
-	const FVector& _nodeLocation = FollowPath.CurrentNode->NodeLocation();
+	const FVector& _nodeLocation = FollowPath.CurrentNodeLocation();
 	const FVector& _direction = _nodeLocation - _agentLocation;
-	OwnerPawn->AddMovementInput(_direction.GetSafeNormal());
+	SteeringDirection = _direction.GetSafeNormal();
+	SteeringNode = FollowPath.CurrentNode;
+	OwnerPawn->AddMovementInput(SteeringDirection);
 	
 	if (IsAgentArrivedAtNode())
 		UpdateAgentPathFollowing();
@@ -123,34 +171,115 @@ bool UNavigationAgentComponent::IsAgentArrivedAtNode() const
 {
 	if (!IsFollowingPath) return false;
 	const FVector _agentLocation = AgentLocation();
-	const FVector _targetLocation = FollowPath.CurrentNode->NodeLocation();
+	const FVector _targetLocation = FollowPath.CurrentNodeLocation();
 	
-	return FVector::Dist(_agentLocation, _targetLocation) < AgentNodeRangeAcceptance;
+	return FVector::Dist(_agentLocation, _targetLocation) < GetNodeRangeAcceptance();
 }
 
 void UNavigationAgentComponent::UpdateAgentPathFollowing()
 {
 	//FollowPath.CurrentNode->Reset...();	//Occupied
-	if (!FollowPath.NextNode())
+	const int _next = FlowField ? NextFlowFieldNode() : FollowPath.NextNode();
+	if (_next == INDEX_NONE)
 	{
 		IsFollowingPath = false;
-		GetWorld()->GetTimerManager().ClearTimer(RecomputeTimerHandle);	
+		CancelRecompute();
 	}
-	FollowPath.PreviousNode->PassedBy(OwnerPawn);
+	SyncAgentSimulation();
+	if (NavigationMesh)
+		NavigationMesh->NodePassedBy(FollowPath.PreviousNode, OwnerPawn);
 	//FollowPath.CurrentNode->Set...(OwnerPawn);	//Occupied
 }
+void UNavigationAgentComponent::SyncAgentSimulation() const
+{
+	if (SimulationSlot == INDEX_NONE) return;
+
+	if (const UWorld* _world = GetWorld())
+		if (UNavigationAgentSubsystem* _agentSubsystem = _world->GetSubsystem<UNavigationAgentSubsystem>())
+			_agentSubsystem->UpdateAgent(this);
+}
+
+#pragma region LOD
+void UNavigationAgentComponent::SetAgentSignificance(const float _significance)
+{
+	AgentSignificance = FMath::Clamp(_significance, 0.0f, 1.0f);
+}
+
+void UNavigationAgentComponent::UpdateAgentLOD()
+{
+	if (LODMode == ENavigationAgentLODMode::AgentLODNone || LODLevels.IsEmpty() || !OwnerPawn) return;
+
+	const int _previous = AgentLOD;
+	if (LODMode == ENavigationAgentLODMode::AgentLODSignificance)
+		AgentLOD = SelectLODLevel(LODLevels, AgentLOD, AgentSignificance, LODSignificanceHysteresis, true);
+	else if (UNavigationAgentSubsystem* _agentSubsystem = GetWorld()->GetSubsystem<UNavigationAgentSubsystem>())
+	{
+		const FVector& _agentLocation = OwnerPawn->GetActorLocation();
+		float _distanceSquared = UE_MAX_FLT;
+		for (const FVector& _viewer : _agentSubsystem->GetViewerLocations())
+			_distanceSquared = FMath::Min(_distanceSquared, static_cast<float>(FVector::DistSquared(_agentLocation, _viewer)));
+		AgentLOD = SelectLODLevel(LODLevels, AgentLOD, FMath::Sqrt(_distanceSquared), LODDistanceHysteresis, false);
+	}
+	if (AgentLOD == _previous) return;
+
+	SteeringTimer = FMath::FRand() * GetUpdateInterval();		//	Spread the steering updates of the Agents entering the bucket together
+	UpdateTickInterval();
+	SyncAgentSimulation();
+}
+
+void UNavigationAgentComponent::UpdateTickInterval()
+{
+	UNavigationAgentSubsystem* _agentSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UNavigationAgentSubsystem>() : nullptr;
+	const bool _hold = SimulationSlot == INDEX_NONE && _agentSubsystem && GetUpdateInterval() > 0;		//	Simulated Agents have no tick of their own
+	SetComponentTickInterval(_hold ? GetUpdateInterval() : 0);
+	if (_hold == IsSteeringHeld) return;
+
+	IsSteeringHeld = _hold;
+	if (_hold)
+		_agentSubsystem->HoldAgentSteering(this);		//	Movement input is consumed every frame
+	else if (_agentSubsystem)
+		_agentSubsystem->ReleaseAgentSteering(this);
+}
+
+int UNavigationAgentComponent::SelectLODLevel(const TArray<FNavigationAgentLODLevel>& _levels, const int _current, const float _value, const float _hysteresis, const bool _isSignificance)
+{
+	if (_levels.IsEmpty()) return 0;
+
+	//	Significance is negated : in both modes a bucket is used while the value is under its border
+	const float _key = _isSignificance ? -_value : _value;
+	auto _border = [&_levels, _isSignificance](const int _level) { return _isSignificance ? -_levels[_level].MinSignificance : _levels[_level].MaxDistance; };
+
+	const int _last = _levels.Num() - 1;
+	int _level = _last;
+	for (int i = 0; i < _last; ++i)
+		if (_key <= _border(i))
+		{
+			_level = i;
+			break;
+		}
+
+	const int _bucket = FMath::Clamp(_current, 0, _last);
+	if (_level > _bucket && _key <= _border(_bucket) + _hysteresis) return _bucket;		//	Not far enough past the border of the current bucket
+	while (_level < _bucket && _key > _border(_level) - _hysteresis)					//	Not far enough inside the finer bucket : one coarser, up to the current one
+		_level++;
+	return _level;
+}
+#pragma endregion
 
 void UNavigationAgentComponent::SetMovementEnable(const bool _enable)
 {
 	MovementEnable = _enable;
+	SyncAgentSimulation();
 }
 void UNavigationAgentComponent::SetRotationEnable(const bool _enable)
 {
 	RotationEnable = _enable;
+	SyncAgentSimulation();
 }
 void UNavigationAgentComponent::SetAgentEnable(const bool _enable)
 {
 	AgentEnable = _enable;
+	SyncAgentSimulation();
 }
 
 void UNavigationAgentComponent::RecomputePath()
@@ -158,11 +287,136 @@ void UNavigationAgentComponent::RecomputePath()
 	if (!IsFollowingPath) return; 
 
 	const FVector& _targetLocation = TargetActor ? TargetActor->GetActorLocation() : TargetLocation;
-	NavigationAlgorithm->ComputePath(FollowPath.CurrentNode, NavigationMesh->GetClosestNode(_targetLocation));
+	if (FlowField && NavigationMesh)
+	{
+		FollowFlowField(FollowPath.CurrentNode, NavigationMesh->GetClosestNodeIndex(_targetLocation));
+		return;
+	}
+	RequestPath(FollowPath.CurrentNode, _targetLocation);
+}
+void UNavigationAgentComponent::ScheduleRecompute()
+{
+	if (UNavigationAgentSubsystem* _agentSubsystem = GetWorld()->GetSubsystem<UNavigationAgentSubsystem>())
+	{
+		_agentSubsystem->ScheduleReplan(this, GetPathRecomputeRate());
+		return;
+	}
+	GetWorld()->GetTimerManager().SetTimer(RecomputeTimerHandle, this, &UNavigationAgentComponent::RecomputePath, GetPathRecomputeRate(), false);
+}
+void UNavigationAgentComponent::CancelRecompute()
+{
+	const UWorld* _world = GetWorld();
+	if (!_world) return;
+
+	if (UNavigationAgentSubsystem* _agentSubsystem = _world->GetSubsystem<UNavigationAgentSubsystem>())
+		_agentSubsystem->CancelReplan(this);
+	_world->GetTimerManager().ClearTimer(RecomputeTimerHandle);
+}
+bool UNavigationAgentComponent::ProcessScheduledReplan()
+{
+	if (!IsFollowingPath) return false;
+	if (ReplanOnChangeOnly && !ShouldRecomputePath())
+	{
+		ScheduleRecompute();
+		return false;
+	}
+
+	RecomputePath();
+	return true;
+}
+bool UNavigationAgentComponent::ShouldRecomputePath() const
+{
+	if (!NavigationMesh) return false;
+	if (NavigationMesh->GetNavigationVersion() != PathQueryVersion) return true;
+
+	//	Goal moved : only its closest Node matters, and only past the threshold (no closest Node query for small moves)
+	const FVector& _goalLocation = TargetActor ? TargetActor->GetActorLocation() : TargetLocation;
+	if (FVector::DistSquared(_goalLocation, PathGoalLocation) > FMath::Square(ReplanGoalThreshold) && NavigationMesh->GetClosestNodeIndex(_goalLocation) != PathGoalNode)
+		return true;
+
+	//	Left the corridor : too far from the segment between the last Node passed and the Node walked to
+	const int _index = FollowPath.PathIndex;
+	if (_index <= 0 || !FollowPath.NodeLocations.IsValidIndex(_index)) return false;
+	return FMath::PointDistToSegment(AgentLocation(), FollowPath.NodeLocations[_index - 1], FollowPath.NodeLocations[_index]) > ReplanCorridorWidth;
+}
+void UNavigationAgentComponent::RequestPath(const int _startNode, const FVector& _targetLocation)
+{
+	if (!NavigationAlgorithm || !NavigationMesh) return;
+
+	const FNavigationGraphPtr& _graph = NavigationMesh->GetNavigationGraph();
+	if (!_graph)
+	{
+		OnPathFailed();
+		return;
+	}
+
+	const int _endNode = NavigationMesh->GetClosestNodeIndex(_targetLocation);
+	PathGoalNode = _endNode;
+	PathGoalLocation = _targetLocation;
+	const FNavigationPathRequest& _request = NavigationMesh->MakePathRequest(_startNode, _endNode, OverrideSearchMode ? SearchMode.GetValue() : NavigationMesh->GetSearchMode());
+	PathQueryVersion = NavigationMesh->GetNavigationVersion();
+	PathQuerySearchMode = _request.Mode;
+
+	if (PathQueryMode == ENavigationPathQueryMode::PathQueryIncremental)
+	{
+		CancelPathQuery();
+		ReplanPath(_graph, _startNode, _endNode);
+		return;
+	}
+
+	TArray<int> _cachedPath = { };
+	if (NavigationMesh->FindCachedPath(_startNode, _endNode, _request.Mode, _cachedPath))
+	{
+		CancelPathQuery();
+		OnPathReceived(UAlgorithmAStar::GetPath(*_graph, _cachedPath));
+		return;
+	}
+
+	if (PathQueryMode != ENavigationPathQueryMode::PathQuerySynchronous)
+	{
+		if (UNavigationPathSubsystem* _pathSubsystem = GetWorld()->GetSubsystem<UNavigationPathSubsystem>())
+		{
+			//	Supersede any query still running for this Agent
+			const FOnNavigationPathQueryCompleted& _onCompleted = FOnNavigationPathQueryCompleted::CreateUObject(this, &UNavigationAgentComponent::OnPathQueryCompleted);
+			PathQuery = PathQueryMode == ENavigationPathQueryMode::PathQueryTimeSliced ?
+				_pathSubsystem->RequestPathTimeSliced(_request, this, PathQueryPriority, _onCompleted) :
+				_pathSubsystem->RequestPath(_request, this, _onCompleted);
+			if (PathQuery.IsValid()) return;
+		}
+	}
+
+	CancelPathQuery();
+	NavigationAlgorithm->ComputePath(_request);
+}
+
+void UNavigationAgentComponent::ReplanPath(const FNavigationGraphPtr& _graph, const int _startNode, const int _endNode)
+{
+	if (!Replanner)
+		Replanner = MakeUnique<FNavigationReplanner>();
+
+	TArray<int> _path = { };
+	const ENavigationReplanResult _result = Replanner->Replan(_graph, _startNode, _endNode, _path, NavigationMesh->GetBlockedNodes());
+	if (_result == ENavigationReplanResult::Failed || _path.IsEmpty())
+	{
+		OnPathFailed();
+		return;
+	}
+	if (_result == ENavigationReplanResult::Reused && IsFollowingPath)		//	Already following this path
+	{
+		ScheduleRecompute();
+		return;
+	}
+
+	OnPathReceived(UAlgorithmAStar::GetPath(*_graph, _path));
 }
 
 void UNavigationAgentComponent::OnPathReceived(FNavigationNodePath _path)
 {
+	if (NavigationMesh && PathQueryMode != ENavigationPathQueryMode::PathQueryIncremental)		//	Replanned paths are not a search of the requested mode
+		NavigationMesh->AddCachedPath(PathQueryVersion, PathQuerySearchMode, _path.NodePath);
+	if (UsePathSmoothing && NavigationMesh)
+		NavigationMesh->SmoothNodePath(_path);		//	Cached unsmoothed : sub paths of the cache must stay chains of neighbors
+
 	if (IsFollowingPath)
 	{
 		FollowPath.UpdatePath(_path);
@@ -172,28 +426,76 @@ void UNavigationAgentComponent::OnPathReceived(FNavigationNodePath _path)
 		IsFollowingPath = true;
 		FollowPath = _path;
 	}
+	SyncAgentSimulation();
 	
-	GetWorld()->GetTimerManager().SetTimer(RecomputeTimerHandle, this, &UNavigationAgentComponent::RecomputePath, PathRecomputeRate, false);
+	ScheduleRecompute();
 	
 	//DrawPath
 	{
 		const int& _max = FollowPath.NodePath.Num();
 		for (int i = 0; i < _max; ++i)
 		{
-			if (const UNavigationNode* _node = FollowPath.NodePath[i])
-			{
-				const FVector& _location = _node->NodeLocation();
-				DrawDebugSphere(GetWorld(), _location, 5, 10, FColor::Blue, false, PathRecomputeRate);
-
-				if (i + 1 < _max)
-					DrawDebugDirectionalArrow(GetWorld(), _location, FollowPath.NodePath[i + 1]->NodeLocation(), 200, FColor::Blue, false, PathRecomputeRate);
-			}
+			const FVector& _location = FollowPath.NodeLocations[i];
+			DrawDebugSphere(GetWorld(), _location, 5, 10, FColor::Blue, false, GetPathRecomputeRate());
+
+			if (i + 1 < _max)
+				DrawDebugDirectionalArrow(GetWorld(), _location, FollowPath.NodeLocations[i + 1], 200, FColor::Blue, false, GetPathRecomputeRate());
 		}
 	}
 }
 void UNavigationAgentComponent::OnPathFailed()
 {
 	IsFollowingPath = false;
+	SyncAgentSimulation();
 	
-	GetWorld()->GetTimerManager().ClearTimer(RecomputeTimerHandle);
+	CancelRecompute();
+}
+void UNavigationAgentComponent::OnPathQueryCompleted(const bool _success, const FNavigationNodePath& _path)
+{
+	PathQuery.Invalidate();
+
+	if (_success)
+		OnPathReceived(_path);
+	else
+		OnPathFailed();
+}
+void UNavigationAgentComponent::CancelPathQuery()
+{
+	if (!PathQuery.IsValid()) return;
+
+	if (const UWorld* _world = GetWorld())
+		if (UNavigationPathSubsystem* _pathSubsystem = _world->GetSubsystem<UNavigationPathSubsystem>())
+			_pathSubsystem->CancelQuery(PathQuery);
+	PathQuery.Invalidate();
+}
+
+void UNavigationAgentComponent::FollowFlowField(const int _startNode, const int _targetNode)
+{
+	CancelPathQuery();
+	FlowField = NavigationMesh ? NavigationMesh->AcquireFlowField(_targetNode, FlowField) : nullptr;	//	Same target : the field already shared is returned
+	PathGoalNode = _targetNode;
+	PathGoalLocation = TargetActor ? TargetActor->GetActorLocation() : TargetLocation;
+	if (NavigationMesh)
+		PathQueryVersion = NavigationMesh->GetNavigationVersion();
+	if (!FlowField || !FlowField->CanReachTarget(IsFollowingPath ? FollowPath.CurrentNode : _startNode))
+	{
+		FlowField = nullptr;
+		OnPathFailed();
+		return;
+	}
+
+	if (!IsFollowingPath)
+	{
+		IsFollowingPath = true;
+		FollowPath = FNavigationNodePath();
+		FollowPath.SetNextNode(_startNode, FlowField->FieldGraph()->NodeLocation(_startNode));
+		SyncAgentSimulation();
+	}
+	ScheduleRecompute();
+}
+int UNavigationAgentComponent::NextFlowFieldNode()
+{
+	const int _next = FlowField->NextNode(FollowPath.CurrentNode);
+	FollowPath.SetNextNode(_next, _next != INDEX_NONE ? FlowField->FieldGraph()->NodeLocation(_next) : FVector::ZeroVector);
+	return _next;
 }
@@ -0,0 +1,288 @@
+#include "NavigationAgentSubsystem.h"
+
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+
+#include "NavigationAgentComponent.h"
+
+#pragma region Agents
+int UNavigationAgentSubsystem::RegisterAgent(UNavigationAgentComponent* _agent)
+{
+	if (!_agent) return INDEX_NONE;
+	if (_agent->SimulationSlot != INDEX_NONE && Agents.IsValidIndex(_agent->SimulationSlot) && Agents[_agent->SimulationSlot] == _agent)
+		return _agent->SimulationSlot;
+
+	const int _slot = Agents.Add(_agent);
+	Pawns.Add(nullptr);
+	Flags.Add(AgentSimulationNone);
+	FeetOffsets.Add(FVector::ZeroVector);
+	AcceptanceSquared.Add(0);
+	RotationSpeeds.Add(0);
+	Targets.Add(FVector::ZeroVector);
+	UpdateIntervals.Add(0);
+	UpdateTimers.Add(0);
+	StepTimes.Add(-1);
+	Locations.Add(FVector::ZeroVector);
+	Velocities.Add(FVector::ZeroVector);
+	Rotations.Add(FRotator::ZeroRotator);
+	Directions.Add(FVector::ZeroVector);
+
+	_agent->SimulationSlot = _slot;
+	UpdateAgent(_agent);
+	return _slot;
+}
+void UNavigationAgentSubsystem::UnregisterAgent(UNavigationAgentComponent* _agent)
+{
+	if (!_agent) return;
+
+	const int _slot = _agent->SimulationSlot;
+	_agent->SimulationSlot = INDEX_NONE;
+	if (!Agents.IsValidIndex(_slot) || Agents[_slot] != _agent) return;
+
+	Agents.RemoveAtSwap(_slot, 1, false);		//	Last Agent moves to the slot
+	Pawns.RemoveAtSwap(_slot, 1, false);
+	Flags.RemoveAtSwap(_slot, 1, false);
+	FeetOffsets.RemoveAtSwap(_slot, 1, false);
+	AcceptanceSquared.RemoveAtSwap(_slot, 1, false);
+	RotationSpeeds.RemoveAtSwap(_slot, 1, false);
+	Targets.RemoveAtSwap(_slot, 1, false);
+	UpdateIntervals.RemoveAtSwap(_slot, 1, false);
+	UpdateTimers.RemoveAtSwap(_slot, 1, false);
+	StepTimes.RemoveAtSwap(_slot, 1, false);
+	Locations.RemoveAtSwap(_slot, 1, false);
+	Velocities.RemoveAtSwap(_slot, 1, false);
+	Rotations.RemoveAtSwap(_slot, 1, false);
+	Directions.RemoveAtSwap(_slot, 1, false);
+	if (Agents.IsValidIndex(_slot))
+		Agents[_slot]->SimulationSlot = _slot;
+}
+void UNavigationAgentSubsystem::UpdateAgent(const UNavigationAgentComponent* _agent)
+{
+	if (!_agent) return;
+
+	const int _slot = _agent->SimulationSlot;
+	if (!Agents.IsValidIndex(_slot) || Agents[_slot] != _agent) return;
+
+	const FNavigationNodePath& _path = _agent->FollowPath;
+	const bool _following = _agent->AgentEnable && _agent->OwnerPawn && _agent->IsFollowingPath && !_path.PathCompleted && _path.NodeLocations.IsValidIndex(_path.PathIndex);
+	uint8 _flags = AgentSimulationNone;
+	if (_following)
+		_flags |= AgentSimulationFollowing;
+	if (_agent->MovementEnable)
+		_flags |= AgentSimulationMovement;
+	if (_agent->RotationEnable)
+		_flags |= AgentSimulationRotation;
+
+	Pawns[_slot] = _agent->OwnerPawn;
+	Flags[_slot] = _flags;
+	FeetOffsets[_slot] = _agent->AgentFeetLocation;
+	AcceptanceSquared[_slot] = FMath::Square(_agent->GetNodeRangeAcceptance());
+	RotationSpeeds[_slot] = _agent->AgentRotationSpeed;
+
+	const float _interval = _agent->GetUpdateInterval();
+	if (_interval != UpdateIntervals[_slot])
+	{
+		UpdateIntervals[_slot] = _interval;
+		UpdateTimers[_slot] = FMath::FRand() * _interval;		//	Spread the Agents entering the bucket together
+	}
+	const FVector& _target = _following ? _path.CurrentNodeLocation() : FVector::ZeroVector;
+	if (_target != Targets[_slot])
+		UpdateTimers[_slot] = _interval;						//	New Node : steer toward it on the next frame
+	Targets[_slot] = _target;
+}
+
+const TArray<FVector>& UNavigationAgentSubsystem::GetViewerLocations()
+{
+	if (ViewerFrame == GFrameCounter) return ViewerLocations;
+
+	ViewerFrame = GFrameCounter;
+	ViewerLocations.Reset();
+	for (FConstPlayerControllerIterator _it = GetWorld()->GetPlayerControllerIterator(); _it; ++_it)
+		if (const APlayerController* _controller = _it->Get())
+		{
+			FVector _location;
+			FRotator _rotation;
+			_controller->GetPlayerViewPoint(_location, _rotation);
+			ViewerLocations.Add(_location);
+		}
+	return ViewerLocations;
+}
+#pragma endregion
+
+#pragma region Replans
+void UNavigationAgentSubsystem::ScheduleReplan(UNavigationAgentComponent* _agent, const float _delay)
+{
+	if (!_agent) return;
+
+	FNavigationReplanEntry _entry;
+	_entry.DueTime = GetWorld()->GetTimeSeconds() + _delay * FMath::FRandRange(0.8f, 1.2f);		//	Jitter : Agents in sync drift apart
+	_entry.Agent = _agent;
+	_entry.Ticket = ++_agent->ReplanTicket;
+	ReplanQueue.HeapPush(_entry);
+}
+void UNavigationAgentSubsystem::CancelReplan(UNavigationAgentComponent* _agent)
+{
+	if (_agent)
+		++_agent->ReplanTicket;		//	Its entry is dropped when it comes out of the queue
+}
+
+void UNavigationAgentSubsystem::SetMaxReplansPerFrame(const int _max)
+{
+	MaxReplansPerFrame = FMath::Max(_max, 1);
+}
+
+void UNavigationAgentSubsystem::ProcessReplans()
+{
+	const double _time = GetWorld()->GetTimeSeconds();
+	int _replans = 0;
+	while (!ReplanQueue.IsEmpty() && ReplanQueue.HeapTop().DueTime <= _time && _replans < MaxReplansPerFrame)
+	{
+		FNavigationReplanEntry _entry;
+		ReplanQueue.HeapPop(_entry, false);
+		UNavigationAgentComponent* _agent = _entry.Agent.Get();
+		if (!_agent || _agent->ReplanTicket != _entry.Ticket) continue;		//	Replaced, cancelled or destroyed
+
+		if (_agent->ProcessScheduledReplan())
+		{
+			ReplanCount++;
+			_replans++;			//	Only actual replans count toward the cap, skipped ones are cheap
+		}
+		else
+			SkippedReplanCount++;
+	}
+}
+#pragma endregion
+
+#pragma region Simulation
+void UNavigationAgentSubsystem::GatherAgents(const float _deltaTime)
+{
+	const int _max = Agents.Num();
+	for (int i = 0; i < _max; ++i)
+	{
+		StepTimes[i] = -1;
+		if ((Flags[i] & AgentSimulationFollowing) == 0) continue;
+
+		UpdateTimers[i] += _deltaTime;
+		if (UpdateTimers[i] < UpdateIntervals[i]) continue;		//	Coarse LOD : last direction kept until the next update
+		StepTimes[i] = UpdateTimers[i];
+		UpdateTimers[i] = 0;
+
+		const APawn* _pawn = Pawns[i];
+		Locations[i] = _pawn->GetActorLocation() + FeetOffsets[i];
+		if ((Flags[i] & AgentSimulationRotation) == 0) continue;
+		Velocities[i] = _pawn->GetVelocity();
+		Rotations[i] = _pawn->GetActorRotation();
+	}
+}
+
+void UNavigationAgentSubsystem::SimulateAgents()
+{
+	const int _max = Agents.Num();
+	Arrived.Reset();
+	for (int i = 0; i < _max; ++i)
+	{
+		if (StepTimes[i] < 0 || (Flags[i] & AgentSimulationMovement) == 0) continue;
+
+		const FVector _delta = Targets[i] - Locations[i];
+		Directions[i] = _delta.GetSafeNormal();
+		if (_delta.SizeSquared() < AcceptanceSquared[i])
+			Arrived.Add(Agents[i]);
+	}
+
+	for (int i = 0; i < _max; ++i)
+	{
+		if (StepTimes[i] < 0 || (Flags[i] & AgentSimulationRotation) == 0) continue;
+
+		const FVector2D _velocity(Velocities[i]);
+		if (_velocity.IsNearlyZero()) continue;		//	No direction to face : keep the current rotation
+
+		const FRotator& _current = Rotations[i];
+		const FRotator _target(0, FMath::RadiansToDegrees(FMath::Atan2(_velocity.Y, _velocity.X)), 0);
+		const float _yaw = FMath::Abs(_current.Yaw - _target.Yaw);
+		Rotations[i] = FMath::RInterpConstantTo(_current, _target, StepTimes[i], RotationSpeeds[i] * _yaw);
+	}
+}
+
+void UNavigationAgentSubsystem::ApplyAgents()
+{
+	const int _max = Agents.Num();
+	for (int i = 0; i < _max; ++i)
+	{
+		const uint8 _flags = Flags[i];
+		if ((_flags & AgentSimulationFollowing) == 0) continue;
+
+		APawn* _pawn = Pawns[i];
+		if (_flags & AgentSimulationMovement)
+			_pawn->AddMovementInput(Directions[i]);
+		if ((_flags & AgentSimulationRotation) && StepTimes[i] >= 0 && !FVector2D(Velocities[i]).IsNearlyZero())
+			_pawn->SetActorRotation(Rotations[i]);
+	}
+}
+
+void UNavigationAgentSubsystem::HoldAgentSteering(UNavigationAgentComponent* _agent)
+{
+	if (_agent)
+		HeldAgents.AddUnique(_agent);
+}
+void UNavigationAgentSubsystem::ReleaseAgentSteering(UNavigationAgentComponent* _agent)
+{
+	HeldAgents.RemoveSwap(_agent);
+}
+
+void UNavigationAgentSubsystem::ApplyHeldSteering()
+{
+	HeldAgents.RemoveAllSwap([](const TWeakObjectPtr<UNavigationAgentComponent>& _agent) { return !_agent.IsValid(); });
+	for (const TWeakObjectPtr<UNavigationAgentComponent>& _held : HeldAgents)
+	{
+		const UNavigationAgentComponent* _agent = _held.Get();
+		if (IsValid(_agent->OwnerPawn) && _agent->AgentEnable && _agent->MovementEnable && _agent->IsFollowingPath && !_agent->FollowPath.PathCompleted)
+			_agent->OwnerPawn->AddMovementInput(_agent->SteeringDirection);
+	}
+}
+
+void UNavigationAgentSubsystem::ProcessArrivals()
+{
+	for (const TWeakObjectPtr<UNavigationAgentComponent>& _agent : Arrived)
+		if (UNavigationAgentComponent* _arrived = _agent.Get())
+			_arrived->UpdateAgentPathFollowing();		//	Pushes its next Node back with UpdateAgent
+	Arrived.Reset();
+}
+#pragma endregion
+
+#pragma region Subsystem
+void UNavigationAgentSubsystem::Deinitialize()
+{
+	for (UNavigationAgentComponent* _agent : Agents)
+		if (_agent)
+			_agent->SimulationSlot = INDEX_NONE;
+	Agents.Empty();
+	Pawns.Empty();
+	ReplanQueue.Empty();
+	HeldAgents.Empty();
+
+	Super::Deinitialize();
+}
+
+void UNavigationAgentSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const double _start = FPlatformTime::Seconds();
+	ProcessReplans();
+	for (int i = Agents.Num() - 1; i >= 0; --i)		//	Pawn destroyed while its Agent is still registered
+		if (!IsValid(Agents[i]) || !IsValid(Pawns[i]))
+			Flags[i] = AgentSimulationNone;
+
+	GatherAgents(DeltaTime);
+	SimulateAgents();
+	ApplyAgents();
+	ApplyHeldSteering();
+	ProcessArrivals();
+	LastFrameSeconds = FPlatformTime::Seconds() - _start;
+}
+
+TStatId UNavigationAgentSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UNavigationAgentSubsystem, STATGROUP_Tickables);
+}
+#pragma endregion
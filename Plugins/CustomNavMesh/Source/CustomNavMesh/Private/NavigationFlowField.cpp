@@ -0,0 +1,94 @@
+#include "NavigationFlowField.h"
+
+#include "NavigationSearch.h"
+
+void FNavigationFlowField::Build(const FNavigationGraphPtr& _graph, const int _targetNode, const FNavigationBlockedNodesPtr& _blocked)
+{
+	Graph = _graph;
+	BlockedNodes = _blocked;
+	TargetNode = _targetNode;
+	const int _max = Graph ? Graph->NodeCount() : 0;
+	Distance.Init(UE_MAX_FLT, _max);
+	Next.Init(INDEX_NONE, _max);
+	if (!Graph || !Graph->IsValidNode(_targetNode) || !Graph->IsNodeAccessible(_targetNode)) return;
+	if (BlockedNodes && BlockedNodes->IsBlocked(_targetNode)) return;
+
+	FNavigationNodeHeap _openList;
+	_openList.Reset(_max);
+	Distance[_targetNode] = 0;
+	_openList.Push(_targetNode, 0);
+	Propagate(_openList);
+}
+
+bool FNavigationFlowField::Retarget(const FNavigationFlowField& _previous, const int _targetNode)
+{
+	if (!_previous.Graph || !_previous.Graph->IsValidNode(_targetNode)) return false;
+
+	if (_previous.Graph->FindEdge(_previous.TargetNode, _targetNode) == INDEX_NONE) return false;
+
+	if (_previous.BlockedNodes && _previous.BlockedNodes->IsBlocked(_targetNode)) return false;
+
+	Graph = _previous.Graph;
+	BlockedNodes = _previous.BlockedNodes;
+	TargetNode = _targetNode;
+	Distance = _previous.Distance;
+	Next = _previous.Next;
+
+	//	Going through the previous target is still a valid path : its cost is an upper bound of the new one
+	const float _edgeCost = Graph->EdgeCost(_previous.TargetNode, _targetNode);
+	const int _max = Distance.Num();
+	for (int i = 0; i < _max; ++i)
+		if (Distance[i] < UE_MAX_FLT)
+			Distance[i] += _edgeCost;
+	Next[_previous.TargetNode] = _targetNode;
+	Distance[_targetNode] = 0;
+	Next[_targetNode] = INDEX_NONE;
+
+	//	Only Nodes with a shorter path to the new target are updated (they are all reached through updated Nodes)
+	FNavigationNodeHeap _openList;
+	_openList.Reset(_max);
+	_openList.Push(_targetNode, 0);
+	Propagate(_openList);
+	return true;
+}
+
+void FNavigationFlowField::Propagate(FNavigationNodeHeap& _openList)
+{
+	const FNavigationGraph& _graph = *Graph;
+	const FNavigationBlockedNodes* _blocked = BlockedNodes.Get();
+	while (!_openList.IsEmpty())
+	{
+		const int _node = _openList.Pop();
+		const float _cost = Distance[_node];
+		const int _end = _graph.ReverseNeighborEnd(_node);
+		for (int e = _graph.ReverseNeighborBegin(_node); e < _end; ++e)		//	Nodes with an edge toward _node
+		{
+			const int _from = _graph.ReverseNeighbors[e];
+			const float _fromCost = _cost + _graph.EdgeCost(_from, _node);
+			if (_fromCost >= Distance[_from]) continue;
+
+			Distance[_from] = _fromCost;
+			Next[_from] = _node;
+			if (!_blocked || !_blocked->IsBlocked(_from))		//	Agents caught on a blocked Node can leave it, but it is never crossed
+				_openList.Push(_from, _fromCost);
+		}
+	}
+}
+
+bool FNavigationFlowField::GetPath(const int _startNode, TArray<int>& _outPath) const
+{
+	_outPath.Reset();
+	if (!CanReachTarget(_startNode)) return false;
+
+	const int _max = Next.Num();
+	for (int _node = _startNode; _node != INDEX_NONE; _node = Next[_node])
+	{
+		_outPath.Add(_node);
+		if (_outPath.Num() > _max)		//	Never happens on a valid field, guard against a loop
+		{
+			_outPath.Reset();
+			return false;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,560 @@
+#include "NavigationGraph.h"
+
+#include "NavigationNode.h"
+
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/Archive.h"
+
+namespace NavigationGraph
+{
+	constexpr uint32 BakeMagic = 0x5247564E;		//	"NVGR"
+	constexpr uint32 BakeVersion = 5;
+	constexpr int64 BakeAlignment = 64;			//	Blocks start on a cache line
+
+	enum EBakeBlock : uint8
+	{
+		BlockPositionX, BlockPositionY, BlockPositionZ, BlockFlags,
+		BlockNeighborOffsets, BlockNeighbors,
+		BlockReverseOffsets, BlockReverseNeighbors,
+		BlockCellOffsets, BlockCellNodes,
+		BlockLandmarkNodes, BlockLandmarkFromCosts, BlockLandmarkToCosts,
+		BlockCount
+	};
+	constexpr int64 BlockElementSize[BlockCount] = { sizeof(float), sizeof(float), sizeof(float), sizeof(uint8), sizeof(int), sizeof(int), sizeof(int), sizeof(int),
+		sizeof(int), sizeof(int), sizeof(int), sizeof(uint16), sizeof(uint16) };
+
+	//	Start of a baked file, written and read as is (little endian platforms)
+	struct FBakeHeader
+	{
+		uint32 Magic = BakeMagic;
+		uint32 Version = BakeVersion;
+		uint32 Checksum = 0;				//	CRC of the blocks
+		int32 NodeCount = 0;
+
+		double LayoutOrigin[3] = { };
+		float LayoutGap = 0;
+		int32 LayoutSizeX = 0;
+		int32 LayoutSizeY = 0;
+		float IndexOriginX = 0;
+		float IndexOriginY = 0;
+		float IndexCellSize = 1;
+		int32 IndexSizeX = 0;
+		int32 IndexSizeY = 0;
+		float LandmarkStep = 1;
+		uint8 LayoutIsSimpleGrid = 0;
+		uint8 IndexIsSimpleGrid = 0;
+		uint8 LandmarkIsSymmetric = 1;
+		uint8 IsSymmetric = 0;				//	No reverse blocks : the reverse adjacency is the forward one
+
+		int64 BlockOffsets[BlockCount] = { };	//	From the start of the file, multiple of BakeAlignment
+		int64 BlockCounts[BlockCount] = { };	//	Elements in each block
+		uint32 BlockCrcs[BlockCount] = { };		//	CRC of each block, checked on load (a corrupted block is found without the mesh checksum)
+	};
+	static_assert(std::is_trivially_copyable_v<FBakeHeader>, "Baked header is written as raw memory");
+
+	template<typename T>
+	TConstArrayView<T> BlockView(const uint8* _data, const FBakeHeader& _header, const EBakeBlock _block)
+	{
+		return TConstArrayView<T>(reinterpret_cast<const T*>(_data + _header.BlockOffsets[_block]), static_cast<int32>(_header.BlockCounts[_block]));
+	}
+
+	//	CSR offsets start at 0, never decrease and end on the element count
+	bool AreOffsetsValid(const TConstArrayView<int> _offsets, const int64 _elementCount)
+	{
+		if (_offsets.IsEmpty()) return _elementCount == 0;
+		if (_offsets[0] != 0 || _offsets.Last() != _elementCount) return false;
+		for (int i = 1; i < _offsets.Num(); ++i)
+			if (_offsets[i] < _offsets[i - 1]) return false;
+		return true;
+	}
+	bool AreIndicesValid(const TConstArrayView<int> _indices, const int64 _max)
+	{
+		for (const int _index : _indices)
+			if (_index < 0 || _index >= _max) return false;
+		return true;
+	}
+}
+
+//	Baked file the arrays of a graph point into : mapped in memory, or read at once where mapping is not supported
+class FNavigationGraphFile
+{
+public:
+	TUniquePtr<IMappedFileHandle> Handle = nullptr;
+	TUniquePtr<IMappedFileRegion> Region = nullptr;		//	Declared after the handle : unmapped before the file is closed
+	TArray64<uint8> Data = { };
+
+	FORCEINLINE const uint8* GetData() const { return Region ? Region->GetMappedPtr() : Data.GetData(); }
+	FORCEINLINE int64 GetSize() const { return Region ? Region->GetMappedSize() : Data.Num(); }
+};
+
+#pragma region Spatial Index
+void FNavigationSpatialIndex::Build(const FNavigationGraph& _graph, const FNavigationGridLayout& _layout, TArray<int>& _cellOffsets, TArray<int>& _cellNodes)
+{
+	_cellOffsets.Reset();
+	_cellNodes.Reset();
+	CellOffsets = _cellOffsets;
+	CellNodes = _cellNodes;
+
+	const int _max = _graph.NodeCount();
+	IsSimpleGrid = _layout.IsSimpleGrid && _layout.Gap > 0 && _layout.SizeX * _layout.SizeY == _max;
+	if (IsSimpleGrid)						//	Node index is given by the cell, nothing to store
+	{
+		OriginX = _layout.Origin.X;
+		OriginY = _layout.Origin.Y;
+		CellSize = _layout.Gap;
+		SizeX = _layout.SizeX;
+		SizeY = _layout.SizeY;
+		return;
+	}
+
+	SizeX = SizeY = 0;
+	float _minX = UE_MAX_FLT, _minY = UE_MAX_FLT, _maxX = -UE_MAX_FLT, _maxY = -UE_MAX_FLT;
+	for (int i = 0; i < _max; ++i)
+	{
+		if (!_graph.IsNodeAccessible(i)) continue;
+		_minX = FMath::Min(_minX, _graph.PositionX[i]);
+		_minY = FMath::Min(_minY, _graph.PositionY[i]);
+		_maxX = FMath::Max(_maxX, _graph.PositionX[i]);
+		_maxY = FMath::Max(_maxY, _graph.PositionY[i]);
+	}
+	if (_minX > _maxX) return;				//	No accessible Node
+
+	OriginX = _minX;
+	OriginY = _minY;
+	CellSize = _layout.Gap > 0 ? _layout.Gap : 100;
+	while (true)							//	Keep the bucket count in the order of the Node count
+	{
+		SizeX = FMath::RoundToInt((_maxX - _minX) / CellSize) + 1;
+		SizeY = FMath::RoundToInt((_maxY - _minY) / CellSize) + 1;
+		if (static_cast<int64>(SizeX) * SizeY <= 4 * static_cast<int64>(_max) + 64) break;
+		CellSize *= 2;
+	}
+
+	const int _cellCount = SizeX * SizeY;
+	_cellOffsets.SetNumZeroed(_cellCount + 1);
+	TArray<int> _nodeCells = { };
+	_nodeCells.SetNumUninitialized(_max);
+	for (int i = 0; i < _max; ++i)
+	{
+		if (!_graph.IsNodeAccessible(i))
+		{
+			_nodeCells[i] = INDEX_NONE;
+			continue;
+		}
+		_nodeCells[i] = CellX(_graph.PositionX[i]) * SizeY + CellY(_graph.PositionY[i]);
+		_cellOffsets[_nodeCells[i] + 1]++;
+	}
+	for (int c = 0; c < _cellCount; ++c)
+		_cellOffsets[c + 1] += _cellOffsets[c];
+
+	_cellNodes.SetNumUninitialized(_cellOffsets[_cellCount]);
+	TArray<int> _cursor = _cellOffsets;
+	for (int i = 0; i < _max; ++i)
+		if (_nodeCells[i] != INDEX_NONE)
+			_cellNodes[_cursor[_nodeCells[i]]++] = i;
+
+	CellOffsets = _cellOffsets;
+	CellNodes = _cellNodes;
+}
+
+int FNavigationSpatialIndex::FindClosestNode(const FNavigationGraph& _graph, const FVector& _worldLocation, const float _maxRange) const
+{
+	if (SizeX <= 0 || SizeY <= 0) return INDEX_NONE;
+
+	int _node = INDEX_NONE;
+	float _last = _maxRange > 0 ? _maxRange * _maxRange : UE_MAX_FLT;		//	Squared distance, same ordering as FVector::Dist
+
+	const float _x = _worldLocation.X;
+	const float _y = _worldLocation.Y;
+	const float _z = _worldLocation.Z;
+	auto _testNode = [&](const int _index)
+	{
+		const float _dx = _graph.PositionX[_index] - _x;
+		const float _dy = _graph.PositionY[_index] - _y;
+		const float _dz = _graph.PositionZ[_index] - _z;
+		const float _dist = _dx * _dx + _dy * _dy + _dz * _dz;
+		if (_dist < _last)
+		{
+			_last = _dist;
+			_node = _index;
+		}
+	};
+	auto _testCell = [&](const int _cellX, const int _cellY)
+	{
+		if (IsSimpleGrid)
+		{
+			const int _index = _cellX * SizeY + _cellY;
+			if (_graph.IsNodeAccessible(_index))
+				_testNode(_index);
+			return;
+		}
+		const int _cell = _cellX * SizeY + _cellY;
+		for (int n = CellOffsets[_cell]; n < CellOffsets[_cell + 1]; ++n)
+			_testNode(CellNodes[n]);
+	};
+
+	const int _centerX = CellX(_x);
+	const int _centerY = CellY(_y);
+	int _maxRing = FMath::Max(FMath::Max(_centerX, SizeX - 1 - _centerX), FMath::Max(_centerY, SizeY - 1 - _centerY));
+	if (_maxRange > 0)
+		_maxRing = FMath::Min(_maxRing, FMath::CeilToInt(_maxRange / CellSize) + 2);
+
+	for (int r = 0; r <= _maxRing; ++r)		//	Check rings of cells around the location, nearest first
+	{
+		const float _ringDistance = (r - 1.5f) * CellSize;		//	Nodes of ring r can't be closer than this (Node and location can be off their cell center)
+		if (_ringDistance > 0 && _ringDistance * _ringDistance >= _last) break;
+
+		const int _minX = FMath::Max(_centerX - r, 0);
+		const int _maxX = FMath::Min(_centerX + r, SizeX - 1);
+		const int _minY = FMath::Max(_centerY - r, 0);
+		const int _maxY = FMath::Min(_centerY + r, SizeY - 1);
+		for (int x = _minX; x <= _maxX; ++x)
+		{
+			if (x == _centerX - r || x == _centerX + r)		//	Ring side : whole column
+			{
+				for (int y = _minY; y <= _maxY; ++y)
+					_testCell(x, y);
+				continue;
+			}
+			if (_centerY - r >= 0)							//	Only top & bottom cells of the column
+				_testCell(x, _centerY - r);
+			if (r > 0 && _centerY + r < SizeY)
+				_testCell(x, _centerY + r);
+		}
+	}
+
+	return _node;
+}
+
+void FNavigationSpatialIndex::FindNodesInBox(const FNavigationGraph& _graph, const FBox2D& _box, TArray<int>& _outNodes) const
+{
+	_outNodes.Reset();
+	if (SizeX <= 0 || SizeY <= 0 || !_box.bIsValid) return;
+
+	//	Nodes are bucketed by rounding : every Node inside the box is in one of these cells
+	const int _minX = FMath::RoundToInt((_box.Min.X - OriginX) / CellSize);
+	const int _maxX = FMath::RoundToInt((_box.Max.X - OriginX) / CellSize);
+	const int _minY = FMath::RoundToInt((_box.Min.Y - OriginY) / CellSize);
+	const int _maxY = FMath::RoundToInt((_box.Max.Y - OriginY) / CellSize);
+	if (_maxX < 0 || _maxY < 0 || _minX >= SizeX || _minY >= SizeY) return;		//	Outside of the grid
+
+	const int _firstX = FMath::Max(_minX, 0), _lastX = FMath::Min(_maxX, SizeX - 1);
+	const int _firstY = FMath::Max(_minY, 0), _lastY = FMath::Min(_maxY, SizeY - 1);
+	for (int x = _firstX; x <= _lastX; ++x)
+		for (int y = _firstY; y <= _lastY; ++y)
+		{
+			const int _cell = x * SizeY + y;
+			if (IsSimpleGrid)
+			{
+				if (_graph.IsNodeAccessible(_cell))
+					_outNodes.Add(_cell);
+				continue;
+			}
+			for (int n = CellOffsets[_cell]; n < CellOffsets[_cell + 1]; ++n)
+				_outNodes.Add(CellNodes[n]);
+		}
+}
+#pragma endregion
+
+#pragma region Graph
+TSharedRef<FNavigationGraph, ESPMode::ThreadSafe> FNavigationGraph::Compile(const TArray<UNavigationNode*>& _nodes, const FNavigationGridLayout& _layout, const int _landmarkCount)
+{
+	TSharedRef<FNavigationGraph, ESPMode::ThreadSafe> _graph = MakeShared<FNavigationGraph, ESPMode::ThreadSafe>();
+	FNavigationGraphArrays& _arrays = _graph->Arrays;
+
+	const int _max = _nodes.Num();
+	_arrays.PositionX.SetNumUninitialized(_max);
+	_arrays.PositionY.SetNumUninitialized(_max);
+	_arrays.PositionZ.SetNumUninitialized(_max);
+	_arrays.Flags.SetNumZeroed(_max);
+	_arrays.NeighborOffsets.SetNumUninitialized(_max + 1);
+
+	int _edgeCount = 0;
+	for (int i = 0; i < _max; ++i)
+		if (const UNavigationNode* _node = _nodes[i])
+			_edgeCount += _node->NodeNeighbors().Num();
+	_arrays.Neighbors.Reserve(_edgeCount);
+
+	for (int i = 0; i < _max; ++i)
+	{
+		_arrays.NeighborOffsets[i] = _arrays.Neighbors.Num();
+
+		const UNavigationNode* _node = _nodes[i];
+		if (!_node)
+		{
+			_arrays.PositionX[i] = _arrays.PositionY[i] = _arrays.PositionZ[i] = 0;
+			continue;
+		}
+
+		const FVector& _location = _node->NodeLocation();
+		_arrays.PositionX[i] = _location.X;
+		_arrays.PositionY[i] = _location.Y;
+		_arrays.PositionZ[i] = _location.Z;
+		if (!_node->IsNodeAccessible()) continue;
+		_arrays.Flags[i] |= NodeFlagAccessible;
+		if (_node->IsNodeWaypoint())
+			_arrays.Flags[i] |= NodeFlagWaypoint;
+
+		const TArray<UNavigationNode*>& _neighbors = _node->NodeNeighbors();
+		const int _neighborMax = _neighbors.Num();
+		for (int n = 0; n < _neighborMax; ++n)
+		{
+			const UNavigationNode* _neighbor = _neighbors[n];
+			if (!_neighbor || !_neighbor->IsNodeAccessible() || !_nodes.IsValidIndex(_neighbor->NodeIndex()) || _nodes[_neighbor->NodeIndex()] != _neighbor)
+				continue;		//	Inaccessible, or not a Node of this Mesh
+
+			_arrays.Neighbors.Add(_neighbor->NodeIndex());
+		}
+	}
+	_arrays.NeighborOffsets[_max] = _arrays.Neighbors.Num();
+
+	_graph->BindArrays();
+	_graph->BuildReverseAdjacency();
+	_graph->Layout = _layout;
+	_graph->SpatialIndex.Build(*_graph, _layout, _arrays.CellOffsets, _arrays.CellNodes);
+	_graph->Landmarks.Build(*_graph, _landmarkCount);
+
+	return _graph;
+}
+
+TSharedRef<FNavigationGraph, ESPMode::ThreadSafe> FNavigationGraph::WithLandmarks(const TSharedRef<const FNavigationGraph, ESPMode::ThreadSafe>& _source, const FNavigationLandmarks& _landmarks)
+{
+	TSharedRef<FNavigationGraph, ESPMode::ThreadSafe> _graph = MakeShared<FNavigationGraph, ESPMode::ThreadSafe>();
+	_graph->PositionX = _source->PositionX;
+	_graph->PositionY = _source->PositionY;
+	_graph->PositionZ = _source->PositionZ;
+	_graph->Flags = _source->Flags;
+	_graph->NeighborOffsets = _source->NeighborOffsets;
+	_graph->Neighbors = _source->Neighbors;
+	_graph->ReverseOffsets = _source->ReverseOffsets;
+	_graph->ReverseNeighbors = _source->ReverseNeighbors;
+	_graph->IsSymmetric = _source->IsSymmetric;
+	_graph->Layout = _source->Layout;
+	_graph->SpatialIndex = _source->SpatialIndex;
+	_graph->Landmarks = _landmarks;
+	_graph->Source = _source;
+	return _graph;
+}
+
+void FNavigationGraph::BindArrays()
+{
+	PositionX = Arrays.PositionX;
+	PositionY = Arrays.PositionY;
+	PositionZ = Arrays.PositionZ;
+	Flags = Arrays.Flags;
+	NeighborOffsets = Arrays.NeighborOffsets;
+	Neighbors = Arrays.Neighbors;
+	ReverseOffsets = IsSymmetric ? NeighborOffsets : Arrays.ReverseOffsets;
+	ReverseNeighbors = IsSymmetric ? Neighbors : Arrays.ReverseNeighbors;
+}
+
+void FNavigationGraph::BuildReverseAdjacency()
+{
+	const int _max = NodeCount();
+	IsSymmetric = true;
+	for (int i = 0; i < _max && IsSymmetric; ++i)
+		for (int e = NeighborBegin(i); e < NeighborEnd(i) && IsSymmetric; ++e)
+			IsSymmetric = FindEdge(Neighbors[e], i) != INDEX_NONE;
+	if (IsSymmetric)						//	Costs only depend on the positions : same edges, same costs
+	{
+		Arrays.ReverseOffsets.Empty();
+		Arrays.ReverseNeighbors.Empty();
+		ReverseOffsets = NeighborOffsets;
+		ReverseNeighbors = Neighbors;
+		return;
+	}
+
+	const int _edgeCount = Neighbors.Num();
+	TArray<int>& _offsets = Arrays.ReverseOffsets;
+	_offsets.Reset();
+	_offsets.SetNumZeroed(_max + 1);
+	for (int e = 0; e < _edgeCount; ++e)
+		_offsets[Neighbors[e] + 1]++;
+	for (int i = 0; i < _max; ++i)
+		_offsets[i + 1] += _offsets[i];
+
+	Arrays.ReverseNeighbors.SetNumUninitialized(_edgeCount);
+	TArray<int> _cursor = _offsets;
+	for (int i = 0; i < _max; ++i)
+		for (int e = NeighborBegin(i); e < NeighborEnd(i); ++e)
+			Arrays.ReverseNeighbors[_cursor[Neighbors[e]]++] = i;
+
+	ReverseOffsets = Arrays.ReverseOffsets;
+	ReverseNeighbors = Arrays.ReverseNeighbors;
+}
+
+void FNavigationGraph::FindChangedNodes(const FNavigationGraph& _previous, const FNavigationGraph& _current, TArray<int>& _outNodes)
+{
+	_outNodes.Reset();
+	const int _max = FMath::Min(_previous.NodeCount(), _current.NodeCount());
+	for (int i = 0; i < _max; ++i)
+	{
+		const int _count = _current.NeighborEnd(i) - _current.NeighborBegin(i);
+		bool _changed = _previous.Flags[i] != _current.Flags[i] || _previous.NeighborEnd(i) - _previous.NeighborBegin(i) != _count
+			|| _previous.PositionX[i] != _current.PositionX[i] || _previous.PositionY[i] != _current.PositionY[i] || _previous.PositionZ[i] != _current.PositionZ[i];
+		for (int n = 0; !_changed && n < _count; ++n)
+			_changed = _previous.Neighbors[_previous.NeighborBegin(i) + n] != _current.Neighbors[_current.NeighborBegin(i) + n];
+		if (_changed)
+			_outNodes.Add(i);
+	}
+}
+
+int FNavigationGraph::FindEdge(const int _from, const int _to) const
+{
+	const int _end = NeighborEnd(_from);
+	for (int e = NeighborBegin(_from); e < _end; ++e)
+		if (Neighbors[e] == _to)
+			return e;
+	return INDEX_NONE;
+}
+
+bool FNavigationGraph::SaveBakedFile(const FString& _path, uint32& _outChecksum) const
+{
+	using namespace NavigationGraph;
+	const TConstArrayView<int> _reverseOffsets = IsSymmetric ? TConstArrayView<int>() : ReverseOffsets;		//	Not written twice
+	const TConstArrayView<int> _reverseNeighbors = IsSymmetric ? TConstArrayView<int>() : ReverseNeighbors;
+	const void* _blocks[BlockCount] = { PositionX.GetData(), PositionY.GetData(), PositionZ.GetData(), Flags.GetData(),
+		NeighborOffsets.GetData(), Neighbors.GetData(), _reverseOffsets.GetData(), _reverseNeighbors.GetData(),
+		SpatialIndex.CellOffsets.GetData(), SpatialIndex.CellNodes.GetData(), Landmarks.Nodes.GetData(), Landmarks.FromCosts.GetData(), Landmarks.ToCosts.GetData() };
+	const int64 _counts[BlockCount] = { PositionX.Num(), PositionY.Num(), PositionZ.Num(), Flags.Num(),
+		NeighborOffsets.Num(), Neighbors.Num(), _reverseOffsets.Num(), _reverseNeighbors.Num(),
+		SpatialIndex.CellOffsets.Num(), SpatialIndex.CellNodes.Num(), Landmarks.Nodes.Num(), Landmarks.FromCosts.Num(), Landmarks.ToCosts.Num() };
+
+	FBakeHeader _header;
+	_header.NodeCount = NodeCount();
+	_header.LayoutOrigin[0] = Layout.Origin.X;
+	_header.LayoutOrigin[1] = Layout.Origin.Y;
+	_header.LayoutOrigin[2] = Layout.Origin.Z;
+	_header.LayoutGap = Layout.Gap;
+	_header.LayoutSizeX = Layout.SizeX;
+	_header.LayoutSizeY = Layout.SizeY;
+	_header.LayoutIsSimpleGrid = Layout.IsSimpleGrid;
+	_header.IndexOriginX = SpatialIndex.OriginX;
+	_header.IndexOriginY = SpatialIndex.OriginY;
+	_header.IndexCellSize = SpatialIndex.CellSize;
+	_header.IndexSizeX = SpatialIndex.SizeX;
+	_header.IndexSizeY = SpatialIndex.SizeY;
+	_header.IndexIsSimpleGrid = SpatialIndex.IsSimpleGrid;
+	_header.LandmarkStep = Landmarks.Step;
+	_header.LandmarkIsSymmetric = Landmarks.IsSymmetric;
+	_header.IsSymmetric = IsSymmetric;
+
+	int64 _offset = Align(static_cast<int64>(sizeof(FBakeHeader)), BakeAlignment);
+	for (int b = 0; b < BlockCount; ++b)
+	{
+		const int64 _size = _counts[b] * BlockElementSize[b];
+		_header.BlockOffsets[b] = _offset;
+		_header.BlockCounts[b] = _counts[b];
+		_header.BlockCrcs[b] = FCrc::MemCrc32(_blocks[b], static_cast<int32>(_size));
+		_header.Checksum = FCrc::MemCrc32(_blocks[b], static_cast<int32>(_size), _header.Checksum);
+		_offset = Align(_offset + _size, BakeAlignment);
+	}
+
+	const TUniquePtr<FArchive> _writer = TUniquePtr<FArchive>(IFileManager::Get().CreateFileWriter(*_path));
+	if (!_writer) return false;
+
+	uint8 _padding[BakeAlignment] = { };
+	_writer->Serialize(&_header, sizeof(FBakeHeader));
+	for (int b = 0; b < BlockCount; ++b)
+	{
+		_writer->Serialize(_padding, _header.BlockOffsets[b] - _writer->Tell());
+		_writer->Serialize(const_cast<void*>(_blocks[b]), _counts[b] * BlockElementSize[b]);
+	}
+	_outChecksum = _header.Checksum;
+	return _writer->Close();
+}
+
+TSharedPtr<FNavigationGraph, ESPMode::ThreadSafe> FNavigationGraph::LoadBakedFile(const FString& _path, const uint32 _checksum)
+{
+	using namespace NavigationGraph;
+	const TSharedRef<FNavigationGraphFile, ESPMode::ThreadSafe> _file = MakeShared<FNavigationGraphFile, ESPMode::ThreadSafe>();
+	_file->Handle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*_path));
+	if (_file->Handle && _file->Handle->GetFileSize() > 0)
+		_file->Region.Reset(_file->Handle->MapRegion(0, _file->Handle->GetFileSize()));
+	if (!_file->Region && !FFileHelper::LoadFileToArray(_file->Data, *_path, FILEREAD_Silent))		//	No mapping on this platform : one read, no parsing
+		return nullptr;
+
+	const int64 _fileSize = _file->GetSize();
+	if (_fileSize < static_cast<int64>(sizeof(FBakeHeader))) return nullptr;
+	FBakeHeader _header;
+	FMemory::Memcpy(&_header, _file->GetData(), sizeof(FBakeHeader));
+	if (_header.Magic != BakeMagic || _header.Version != BakeVersion || _header.Checksum != _checksum) return nullptr;
+
+	//	Reject a truncated file before the views point out of it
+	const int64 _max = _header.NodeCount;
+	const int64 _edgeCount = _header.BlockCounts[BlockNeighbors];
+	const int64 _cellCount = _header.IndexIsSimpleGrid || _header.IndexSizeX <= 0 ? 0 : static_cast<int64>(_header.IndexSizeX) * _header.IndexSizeY + 1;
+	const int64 _landmarkCount = _header.BlockCounts[BlockLandmarkNodes];
+	const int64 _landmarkCosts = _landmarkCount * _max;
+	const bool _isSymmetric = _header.IsSymmetric != 0;
+	const int64 _expected[BlockCount] = { _max, _max, _max, _max, _max + 1, _edgeCount, _isSymmetric ? 0 : _max + 1, _isSymmetric ? 0 : _edgeCount,
+		_cellCount, _header.BlockCounts[BlockCellNodes], _landmarkCount, _landmarkCosts, _header.LandmarkIsSymmetric ? 0 : _landmarkCosts };
+	if (_max < 0 || _edgeCount < 0 || _edgeCount > MAX_int32 || _header.BlockCounts[BlockCellNodes] > _max || _landmarkCount < 0 || _landmarkCosts > MAX_int32) return nullptr;
+	for (int b = 0; b < BlockCount; ++b)
+		if (_header.BlockCounts[b] != _expected[b] || _header.BlockOffsets[b] % BakeAlignment != 0 || _header.BlockOffsets[b] < static_cast<int64>(sizeof(FBakeHeader))
+			|| _header.BlockOffsets[b] + _header.BlockCounts[b] * BlockElementSize[b] > _fileSize) return nullptr;
+
+	//	Reject a corrupted file before a search indexes out of the arrays : every block is read once here
+	const uint8* _data = _file->GetData();
+	for (int b = 0; b < BlockCount; ++b)
+		if (FCrc::MemCrc32(_data + _header.BlockOffsets[b], static_cast<int32>(_header.BlockCounts[b] * BlockElementSize[b])) != _header.BlockCrcs[b])
+		{
+			UE_LOG(LogTemp, Error, TEXT("ERROR : Baked Navigation Mesh graph %s is corrupted (block %d)"), *_path, b);
+			return nullptr;
+		}
+	if (_header.IndexIsSimpleGrid && static_cast<int64>(_header.IndexSizeX) * _header.IndexSizeY != _max) return nullptr;		//	Cells index the Nodes directly
+	if (!AreOffsetsValid(BlockView<int>(_data, _header, BlockNeighborOffsets), _edgeCount)
+		|| (!_isSymmetric && !AreOffsetsValid(BlockView<int>(_data, _header, BlockReverseOffsets), _edgeCount))
+		|| !AreOffsetsValid(BlockView<int>(_data, _header, BlockCellOffsets), _header.BlockCounts[BlockCellNodes])
+		|| !AreIndicesValid(BlockView<int>(_data, _header, BlockNeighbors), _max) || !AreIndicesValid(BlockView<int>(_data, _header, BlockReverseNeighbors), _max)
+		|| !AreIndicesValid(BlockView<int>(_data, _header, BlockCellNodes), _max) || !AreIndicesValid(BlockView<int>(_data, _header, BlockLandmarkNodes), _max))
+	{
+		UE_LOG(LogTemp, Error, TEXT("ERROR : Baked Navigation Mesh graph %s has Node indices out of range"), *_path);
+		return nullptr;
+	}
+
+	const TSharedRef<FNavigationGraph, ESPMode::ThreadSafe> _graph = MakeShared<FNavigationGraph, ESPMode::ThreadSafe>();
+	_graph->PositionX = BlockView<float>(_data, _header, BlockPositionX);
+	_graph->PositionY = BlockView<float>(_data, _header, BlockPositionY);
+	_graph->PositionZ = BlockView<float>(_data, _header, BlockPositionZ);
+	_graph->Flags = BlockView<uint8>(_data, _header, BlockFlags);
+	_graph->NeighborOffsets = BlockView<int>(_data, _header, BlockNeighborOffsets);
+	_graph->Neighbors = BlockView<int>(_data, _header, BlockNeighbors);
+	_graph->IsSymmetric = _isSymmetric;
+	_graph->ReverseOffsets = _isSymmetric ? _graph->NeighborOffsets : BlockView<int>(_data, _header, BlockReverseOffsets);
+	_graph->ReverseNeighbors = _isSymmetric ? _graph->Neighbors : BlockView<int>(_data, _header, BlockReverseNeighbors);
+
+	_graph->Layout = FNavigationGridLayout(FVector(_header.LayoutOrigin[0], _header.LayoutOrigin[1], _header.LayoutOrigin[2]), _header.LayoutGap,
+		_header.LayoutSizeX, _header.LayoutSizeY, _header.LayoutIsSimpleGrid != 0);
+	FNavigationSpatialIndex& _index = _graph->SpatialIndex;
+	_index.OriginX = _header.IndexOriginX;
+	_index.OriginY = _header.IndexOriginY;
+	_index.CellSize = _header.IndexCellSize;
+	_index.SizeX = _header.IndexSizeX;
+	_index.SizeY = _header.IndexSizeY;
+	_index.IsSimpleGrid = _header.IndexIsSimpleGrid != 0;
+	_index.CellOffsets = BlockView<int>(_data, _header, BlockCellOffsets);
+	_index.CellNodes = BlockView<int>(_data, _header, BlockCellNodes);
+
+	FNavigationLandmarks& _landmarks = _graph->Landmarks;
+	_landmarks.Count = static_cast<int>(_landmarkCount);
+	_landmarks.Step = _header.LandmarkStep;
+	_landmarks.IsSymmetric = _header.LandmarkIsSymmetric != 0;
+	_landmarks.Nodes = BlockView<int>(_data, _header, BlockLandmarkNodes);
+	_landmarks.FromCosts = BlockView<uint16>(_data, _header, BlockLandmarkFromCosts);
+	_landmarks.ToCosts = BlockView<uint16>(_data, _header, BlockLandmarkToCosts);
+
+	_graph->File = _file;
+	return _graph;
+}
+
+FString FNavigationGraph::GetBakedFilePath(const FString& _root, const FString& _meshName)
+{
+	return FPaths::Combine(_root, TEXT("NavigationGraphs"), _meshName + TEXT(".navgraph"));
+}
+#pragma endregion
@@ -0,0 +1,404 @@
+#include "NavigationHierarchy.h"
+
+#include "NavigationSearch.h"
+
+#pragma region Build
+void FNavigationHierarchy::Build(const FNavigationGraph& _graph, const int _clusterSize, FNavigationSearch& _scratch)
+{
+	ComputeClusterGrid(_graph, _clusterSize);
+	Transitions.Reset();
+	AbstractEdges.Reset();
+	ClusterEntrances.Reset();
+	ClusterEntrances.SetNum(ClusterCount());
+
+	const int _max = _graph.NodeCount();
+	for (int u = 0; u < _max; ++u)						//	Every edge crossing a cluster border (only accessible Nodes are linked)
+	{
+		const int _cluster = NodeCluster[u];
+		const int _end = _graph.NeighborEnd(u);
+		for (int e = _graph.NeighborBegin(u); e < _end; ++e)
+		{
+			const int v = _graph.Neighbors[e];
+			if (NodeCluster[v] != _cluster)
+				Transitions.FindOrAdd(PairKey(_cluster, NodeCluster[v])).Add(FIntPoint(u, v));
+		}
+	}
+	for (TPair<uint64, TArray<FIntPoint>>& _transition : Transitions)
+		ReduceTransitions(_graph, _transition.Value);
+
+	TSet<int> _clusters = { };
+	_clusters.Reserve(ClusterCount());
+	for (int c = 0; c < ClusterCount(); ++c)
+		_clusters.Add(c);
+	UpdateClusters(_graph, _clusters, _scratch);
+}
+
+bool FNavigationHierarchy::IsCompatible(const FNavigationGraph& _graph, const int _clusterSize) const
+{
+	if (ClusterSize != _clusterSize || NodeCluster.Num() != _graph.NodeCount()) return false;
+
+	FNavigationHierarchy _grid;
+	_grid.ComputeClusterGrid(_graph, _clusterSize);
+	return _grid.ClusterCount() == ClusterCount() && _grid.NodeCluster == NodeCluster;
+}
+
+void FNavigationHierarchy::RebuildClusters(const FNavigationGraph& _graph, const TArray<int>& _changedNodes, FNavigationSearch& _scratch)
+{
+	TSet<int> _dirty = { };
+	for (const int _node : _changedNodes)
+		if (NodeCluster.IsValidIndex(_node))
+			_dirty.Add(NodeCluster[_node]);
+	if (_dirty.IsEmpty()) return;
+
+	//	Forget the entrances of the dirty clusters, their neighbor clusters must update their entrances too
+	TSet<int> _affected = _dirty;
+	for (auto _it = Transitions.CreateIterator(); _it; ++_it)
+	{
+		const int _from = static_cast<int>(_it.Key() >> 32);
+		const int _to = static_cast<int>(_it.Key() & 0xFFFFFFFF);
+		if (!_dirty.Contains(_from) && !_dirty.Contains(_to)) continue;
+
+		_affected.Add(_from);
+		_affected.Add(_to);
+		_it.RemoveCurrent();
+	}
+
+	TSet<uint64> _rebuilt = { };
+	for (const int c : _dirty)
+	{
+		for (int n = ClusterOffsets[c]; n < ClusterOffsets[c + 1]; ++n)
+		{
+			const int u = ClusterNodes[n];
+			for (int e = _graph.NeighborBegin(u); e < _graph.NeighborEnd(u); ++e)
+			{
+				const int v = _graph.Neighbors[e];
+				if (NodeCluster[v] == c) continue;
+
+				const uint64 _key = PairKey(c, NodeCluster[v]);
+				Transitions.FindOrAdd(_key).Add(FIntPoint(u, v));
+				_rebuilt.Add(_key);
+				_affected.Add(NodeCluster[v]);
+			}
+			for (int e = _graph.ReverseNeighborBegin(u); e < _graph.ReverseNeighborEnd(u); ++e)
+			{
+				const int w = _graph.ReverseNeighbors[e];
+				if (_dirty.Contains(NodeCluster[w])) continue;		//	Added by the forward pass of its own cluster
+
+				const uint64 _key = PairKey(NodeCluster[w], c);
+				Transitions.FindOrAdd(_key).Add(FIntPoint(w, u));
+				_rebuilt.Add(_key);
+				_affected.Add(NodeCluster[w]);
+			}
+		}
+	}
+	for (const uint64 _key : _rebuilt)
+		ReduceTransitions(_graph, Transitions[_key]);
+
+	UpdateClusters(_graph, _affected, _scratch);
+}
+
+void FNavigationHierarchy::ComputeClusterGrid(const FNavigationGraph& _graph, const int _clusterSize)
+{
+	ClusterSize = FMath::Max(1, _clusterSize);
+	const int _max = _graph.NodeCount();
+	const float _gap = _graph.Layout.Gap > 0 ? _graph.Layout.Gap : 100;
+
+	float _minX = UE_MAX_FLT, _minY = UE_MAX_FLT, _maxX = -UE_MAX_FLT, _maxY = -UE_MAX_FLT;
+	for (int i = 0; i < _max; ++i)			//	All Nodes : clusters must not move when accessibility changes
+	{
+		_minX = FMath::Min(_minX, _graph.PositionX[i]);
+		_minY = FMath::Min(_minY, _graph.PositionY[i]);
+		_maxX = FMath::Max(_maxX, _graph.PositionX[i]);
+		_maxY = FMath::Max(_maxY, _graph.PositionY[i]);
+	}
+	if (_max == 0)
+		_minX = _minY = _maxX = _maxY = 0;
+
+	OriginX = _minX - _gap * 0.5f;			//	Nodes sit in the middle of their grid cell
+	OriginY = _minY - _gap * 0.5f;
+	ClusterWorldSize = _gap * ClusterSize;
+	ClustersX = FMath::FloorToInt((_maxX - OriginX) / ClusterWorldSize) + 1;
+	ClustersY = FMath::FloorToInt((_maxY - OriginY) / ClusterWorldSize) + 1;
+
+	const int _clusterCount = ClusterCount();
+	NodeCluster.SetNumUninitialized(_max);
+	ClusterOffsets.Reset();
+	ClusterOffsets.SetNumZeroed(_clusterCount + 1);
+	for (int i = 0; i < _max; ++i)
+	{
+		const int _x = FMath::Clamp(FMath::FloorToInt((_graph.PositionX[i] - OriginX) / ClusterWorldSize), 0, ClustersX - 1);
+		const int _y = FMath::Clamp(FMath::FloorToInt((_graph.PositionY[i] - OriginY) / ClusterWorldSize), 0, ClustersY - 1);
+		NodeCluster[i] = _x * ClustersY + _y;
+		ClusterOffsets[NodeCluster[i] + 1]++;
+	}
+	for (int c = 0; c < _clusterCount; ++c)
+		ClusterOffsets[c + 1] += ClusterOffsets[c];
+
+	ClusterNodes.SetNumUninitialized(_max);
+	TArray<int> _cursor = ClusterOffsets;
+	for (int i = 0; i < _max; ++i)
+		ClusterNodes[_cursor[NodeCluster[i]]++] = i;
+}
+
+void FNavigationHierarchy::ReduceTransitions(const FNavigationGraph& _graph, TArray<FIntPoint>& _edges)
+{
+	if (_edges.Num() <= 1) return;
+
+	TSet<int> _sources = { };
+	for (const FIntPoint& _edge : _edges)
+		_sources.Add(_edge.X);
+
+	TArray<FIntPoint> _entrances = { };
+	TSet<int> _done = { };
+	TArray<int> _run = { };
+	for (const FIntPoint& _edge : _edges)
+	{
+		if (_done.Contains(_edge.X)) continue;
+
+		_run.Reset();							//	Border Nodes linked together form one entrance
+		_run.Add(_edge.X);
+		_done.Add(_edge.X);
+		for (int r = 0; r < _run.Num(); ++r)
+			for (int e = _graph.NeighborBegin(_run[r]); e < _graph.NeighborEnd(_run[r]); ++e)
+			{
+				const int _next = _graph.Neighbors[e];
+				if (_sources.Contains(_next) && !_done.Contains(_next))
+				{
+					_done.Add(_next);
+					_run.Add(_next);
+				}
+			}
+
+		_run.Sort();							//	Node indices follow the grid : the middle index is the middle of the run
+		const int _middle = _run[_run.Num() / 2];
+		for (const FIntPoint& _candidate : _edges)
+			if (_candidate.X == _middle)
+			{
+				_entrances.Add(_candidate);
+				break;
+			}
+	}
+	_edges = MoveTemp(_entrances);
+}
+
+void FNavigationHierarchy::UpdateClusters(const FNavigationGraph& _graph, const TSet<int>& _clusters, FNavigationSearch& _scratch)
+{
+	const FNavigationSearchState& _state = _scratch.ScratchState();
+	TSet<int> _linked = { };
+	TSet<int> _entrances = { };
+	for (const int c : _clusters)
+	{
+		for (const int _entrance : ClusterEntrances[c])
+			AbstractEdges.Remove(_entrance);
+
+		_linked.Reset();
+		_entrances.Reset();
+		GetLinkedClusters(_graph, c, _linked);
+		for (const int d : _linked)
+		{
+			if (const TArray<FIntPoint>* _out = Transitions.Find(PairKey(c, d)))
+				for (const FIntPoint& _edge : *_out)
+					_entrances.Add(_edge.X);
+			if (const TArray<FIntPoint>* _in = Transitions.Find(PairKey(d, c)))
+				for (const FIntPoint& _edge : *_in)
+					_entrances.Add(_edge.Y);
+		}
+		TArray<int>& _clusterEntrances = ClusterEntrances[c];
+		_clusterEntrances = _entrances.Array();
+		_clusterEntrances.Sort();
+
+		for (const int _entrance : _clusterEntrances)
+			AbstractEdges.Add(_entrance);
+		for (const int d : _linked)				//	Entrance edges toward the other clusters
+			if (const TArray<FIntPoint>* _out = Transitions.Find(PairKey(c, d)))
+				for (const FIntPoint& _edge : *_out)
+					AbstractEdges[_edge.X].Add(FNavigationAbstractEdge(_edge.Y, _graph.EdgeCost(_edge.X, _edge.Y)));
+
+		for (const int _entrance : _clusterEntrances)		//	Intra cluster costs between entrances
+		{
+			ClusterSearch(_graph, _entrance, c, false, INDEX_NONE, _scratch);
+			TArray<FNavigationAbstractEdge>& _edges = AbstractEdges[_entrance];
+			for (const int _other : _clusterEntrances)
+				if (_other != _entrance && _state.IsClosed(_other))
+					_edges.Add(FNavigationAbstractEdge(_other, _state.Cost[_other]));
+		}
+	}
+}
+
+void FNavigationHierarchy::GetLinkedClusters(const FNavigationGraph& _graph, const int _cluster, TSet<int>& _outClusters) const
+{
+	for (int n = ClusterOffsets[_cluster]; n < ClusterOffsets[_cluster + 1]; ++n)
+	{
+		const int u = ClusterNodes[n];
+		for (int e = _graph.NeighborBegin(u); e < _graph.NeighborEnd(u); ++e)
+			if (NodeCluster[_graph.Neighbors[e]] != _cluster)
+				_outClusters.Add(NodeCluster[_graph.Neighbors[e]]);
+		for (int e = _graph.ReverseNeighborBegin(u); e < _graph.ReverseNeighborEnd(u); ++e)
+			if (NodeCluster[_graph.ReverseNeighbors[e]] != _cluster)
+				_outClusters.Add(NodeCluster[_graph.ReverseNeighbors[e]]);
+	}
+}
+#pragma endregion
+
+#pragma region Search
+bool FNavigationHierarchy::FindPath(const FNavigationGraph& _graph, const int _startNode, const int _endNode, FNavigationSearch& _scratch, TArray<int>& _outPath) const
+{
+	_outPath.Reset();
+	if (!_graph.IsValidNode(_startNode) || !_graph.IsValidNode(_endNode) || NodeCluster.Num() != _graph.NodeCount()) return false;
+	if (_startNode == _endNode)
+	{
+		_outPath.Add(_startNode);
+		return true;
+	}
+
+	FNavigationSearchState& _state = _scratch.ScratchState();
+	FNavigationNodeHeap& _openList = _scratch.ScratchOpenList();
+	const int _startCluster = NodeCluster[_startNode];
+	const int _endCluster = NodeCluster[_endNode];
+
+	//	Temporary abstract edges : Start Node -> entrances of its cluster (and End Node when it is in the same cluster)
+	TArray<FNavigationAbstractEdge> _startEdges = { };
+	ClusterSearch(_graph, _startNode, _startCluster, false, INDEX_NONE, _scratch);
+	for (const int _entrance : ClusterEntrances[_startCluster])
+		if (_entrance != _startNode && _state.IsClosed(_entrance))
+			_startEdges.Add(FNavigationAbstractEdge(_entrance, _state.Cost[_entrance]));
+	if (_startCluster == _endCluster && _state.IsClosed(_endNode))
+		_startEdges.Add(FNavigationAbstractEdge(_endNode, _state.Cost[_endNode]));
+
+	//	Entrances of the End Node cluster -> End Node
+	TMap<int, float> _endEdges = { };
+	ClusterSearch(_graph, _endNode, _endCluster, true, INDEX_NONE, _scratch);
+	for (const int _entrance : ClusterEntrances[_endCluster])
+		if (_state.IsClosed(_entrance))
+			_endEdges.Add(_entrance, _state.Cost[_entrance]);
+
+	//	A* over the entrances (edge costs are >= the distance : the heuristic is consistent)
+	const int _nodeCount = _graph.NodeCount();
+	const FVector _endLocation = _graph.NodeLocation(_endNode);
+	_state.Reset(_nodeCount);
+	_openList.Reset(_nodeCount);
+	auto _relax = [&](const int _from, const int _to, const float _cost)
+	{
+		if (!_state.IsVisited(_to))
+			_state.Visit(_to);
+		else if (_state.Closed[_to])
+			return;
+
+		const float _nextCost = _state.Cost[_from] + _cost;
+		if (_nextCost < _state.Cost[_to])
+		{
+			_state.Cost[_to] = _nextCost;
+			_state.Parent[_to] = _from;
+			_openList.Push(_to, _nextCost + FVector::Dist(_graph.NodeLocation(_to), _endLocation));
+		}
+	};
+
+	_state.Visit(_startNode);
+	_state.Cost[_startNode] = 0;
+	_openList.Push(_startNode, FVector::Dist(_graph.NodeLocation(_startNode), _endLocation));
+	bool _found = false;
+	while (!_openList.IsEmpty())
+	{
+		const int _node = _openList.Pop();
+		_state.Closed[_node] = true;
+		if (_node == _endNode)
+		{
+			_found = true;
+			break;
+		}
+
+		if (_node == _startNode)
+			for (const FNavigationAbstractEdge& _edge : _startEdges)
+				_relax(_node, _edge.Target, _edge.Cost);
+		if (const TArray<FNavigationAbstractEdge>* _edges = AbstractEdges.Find(_node))
+			for (const FNavigationAbstractEdge& _edge : *_edges)
+				_relax(_node, _edge.Target, _edge.Cost);
+		if (const float* _endCost = _endEdges.Find(_node))
+			_relax(_node, _endNode, *_endCost);
+	}
+	if (!_found) return false;
+
+	TArray<int> _abstractPath = { };
+	for (int _node = _endNode; _node != _startNode; _node = _state.Parent[_node])
+		_abstractPath.Add(_node);
+	_abstractPath.Add(_startNode);
+	Algo::Reverse(_abstractPath);
+
+	//	Refine the corridor : entrance edges are graph edges, everything else is a path inside one cluster
+	_outPath.Add(_startNode);
+	const int _max = _abstractPath.Num();
+	for (int i = 1; i < _max; ++i)
+	{
+		const int _from = _abstractPath[i - 1];
+		const int _to = _abstractPath[i];
+		if (NodeCluster[_from] != NodeCluster[_to])
+		{
+			_outPath.Add(_to);
+			continue;
+		}
+
+		ClusterSearch(_graph, _from, NodeCluster[_from], false, _to, _scratch);
+		if (!AppendClusterPath(_from, _to, _scratch, _outPath))
+		{
+			_outPath.Reset();
+			return false;
+		}
+	}
+	return true;
+}
+
+void FNavigationHierarchy::ClusterSearch(const FNavigationGraph& _graph, const int _source, const int _cluster, const bool _reverse, const int _stopNode, FNavigationSearch& _scratch) const
+{
+	FNavigationSearchState& _state = _scratch.ScratchState();
+	FNavigationNodeHeap& _openList = _scratch.ScratchOpenList();
+	_state.Reset(_graph.NodeCount());
+	_openList.Reset(_graph.NodeCount());
+	_state.Visit(_source);
+	_state.Cost[_source] = 0;
+	_openList.Push(_source, 0);
+
+	const TConstArrayView<int> _neighbors = _reverse ? _graph.ReverseNeighbors : _graph.Neighbors;		//	Views : no copy of the CSR
+	while (!_openList.IsEmpty())
+	{
+		const int _node = _openList.Pop();
+		_state.Closed[_node] = true;
+		if (_node == _stopNode) return;
+
+		const float _cost = _state.Cost[_node];
+		const int _end = _reverse ? _graph.ReverseNeighborEnd(_node) : _graph.NeighborEnd(_node);
+		for (int e = _reverse ? _graph.ReverseNeighborBegin(_node) : _graph.NeighborBegin(_node); e < _end; ++e)
+		{
+			const int _next = _neighbors[e];
+			if (NodeCluster[_next] != _cluster) continue;
+			if (!_state.IsVisited(_next))
+				_state.Visit(_next);
+			else if (_state.Closed[_next])
+				continue;
+
+			const float _nextCost = _cost + _graph.EdgeCost(_node, _next);
+			if (_nextCost < _state.Cost[_next])
+			{
+				_state.Cost[_next] = _nextCost;
+				_state.Parent[_next] = _node;
+				_openList.Push(_next, _nextCost);
+			}
+		}
+	}
+}
+
+bool FNavigationHierarchy::AppendClusterPath(const int _source, const int _target, const FNavigationSearch& _scratch, TArray<int>& _outPath)
+{
+	const FNavigationSearchState& _state = _scratch.ScratchState();
+	if (!_state.IsClosed(_target)) return false;
+
+	const int _first = _outPath.Num();
+	for (int _node = _target; _node != _source; _node = _state.Parent[_node])
+	{
+		if (_node == INDEX_NONE) return false;
+		_outPath.Add(_node);
+	}
+	for (int i = _first, j = _outPath.Num() - 1; i < j; ++i, --j)
+		_outPath.Swap(i, j);
+	return true;
+}
+#pragma endregion
@@ -0,0 +1,219 @@
+#include "NavigationJumpPointSearch.h"
+
+#include "NavigationSearch.h"
+
+#pragma region Build
+bool FNavigationJumpPointGrid::Build(const FNavigationGraph& _graph)
+{
+	if (!_graph.SpatialIndex.IsSimpleGrid) return false;
+
+	const FNavigationGridLayout& _layout = _graph.Layout;
+	SizeX = _layout.SizeX;
+	SizeY = _layout.SizeY;
+	StraightCost = FNavigationGraph::ComputeEdgeCost(FVector::ZeroVector, FVector(_layout.Gap, 0, 0));
+	DiagonalCost = FNavigationGraph::ComputeEdgeCost(FVector::ZeroVector, FVector(_layout.Gap, _layout.Gap, 0));
+
+	const int _max = _graph.NodeCount();
+	Open.Init(false, _max);
+	JumpStop.Init(false, _max);
+	IrregularCount = 0;
+	for (int i = 0; i < _max; ++i)
+		Open[i] = _graph.IsNodeAccessible(i);
+
+	for (int i = 0; i < _max; ++i)
+	{
+		if (!Open[i]) continue;
+
+		const int _x = i / SizeY;
+		const int _y = i % SizeY;
+		int _openNeighbors = 0;
+		for (int _dx = -1; _dx <= 1; ++_dx)
+			for (int _dy = -1; _dy <= 1; ++_dy)
+				if ((_dx || _dy) && IsOpen(_x + _dx, _y + _dy))
+					_openNeighbors++;
+
+		//	Regular cell : linked to all its open neighbors with the flat grid costs (slopes within 1% are still flat)
+		bool _regular = _graph.NeighborEnd(i) - _graph.NeighborBegin(i) == _openNeighbors;
+		for (int e = _graph.NeighborBegin(i); _regular && e < _graph.NeighborEnd(i); ++e)
+		{
+			const int _dx = _graph.Neighbors[e] / SizeY - _x;
+			const int _dy = _graph.Neighbors[e] % SizeY - _y;
+			if (FMath::Abs(_dx) > 1 || FMath::Abs(_dy) > 1)
+			{
+				_regular = false;
+				continue;
+			}
+			const float _cost = _dx && _dy ? DiagonalCost : StraightCost;
+			_regular = FMath::Abs(_graph.EdgeCost(i, _graph.Neighbors[e]) - _cost) <= _cost * 0.01f;
+		}
+		if (_regular) continue;
+
+		IrregularCount++;
+		for (int _dx = -1; _dx <= 1; ++_dx)
+			for (int _dy = -1; _dy <= 1; ++_dy)
+				if (_x + _dx >= 0 && _y + _dy >= 0 && _x + _dx < SizeX && _y + _dy < SizeY)
+					JumpStop[CellIndex(_x + _dx, _y + _dy)] = true;
+	}
+	return true;
+}
+#pragma endregion
+
+#pragma region Search
+bool FNavigationJumpPointGrid::FindPath(const FNavigationGraph& _graph, const int _startNode, const int _endNode, FNavigationSearch& _scratch, TArray<int>& _outPath) const
+{
+	_outPath.Reset();
+	const int _max = _graph.NodeCount();
+	if (Open.Num() != _max || !_graph.IsValidNode(_startNode) || !_graph.IsValidNode(_endNode)) return false;
+
+	FNavigationSearchState& _state = _scratch.ScratchState();
+	FNavigationNodeHeap& _openList = _scratch.ScratchOpenList();
+	_state.Reset(_max);
+	_openList.Reset(_max);
+
+	//	Planar distance : every edge (grid step or Node Linker) costs at least that much
+	const FVector2D _endLocation = FVector2D(_graph.PositionX[_endNode], _graph.PositionY[_endNode]);
+	auto _heuristic = [&](const int _node) { return FVector2D::Distance(FVector2D(_graph.PositionX[_node], _graph.PositionY[_node]), _endLocation); };
+	auto _relax = [&](const int _from, const int _to, const float _cost)
+	{
+		if (!_state.IsVisited(_to))
+			_state.Visit(_to);
+		else if (_state.Closed[_to])
+			return;
+
+		const float _nextCost = _state.Cost[_from] + _cost;
+		if (_nextCost < _state.Cost[_to])
+		{
+			_state.Cost[_to] = _nextCost;
+			_state.Parent[_to] = _from;
+			_openList.Push(_to, _nextCost + _heuristic(_to));
+		}
+	};
+	auto _relaxJump = [&](const int _from, const int _x, const int _y, const int _dx, const int _dy)
+	{
+		const int _jumpPoint = Jump(_x, _y, _dx, _dy, _endNode);
+		if (_jumpPoint == INDEX_NONE) return;
+
+		const int _steps = FMath::Max(FMath::Abs(_jumpPoint / SizeY - _x), FMath::Abs(_jumpPoint % SizeY - _y));
+		_relax(_from, _jumpPoint, _steps * (_dx && _dy ? DiagonalCost : StraightCost));
+	};
+
+	_state.Visit(_startNode);
+	_state.Cost[_startNode] = 0;
+	_openList.Push(_startNode, _heuristic(_startNode));
+	bool _found = false;
+	while (!_openList.IsEmpty())
+	{
+		const int _node = _openList.Pop();
+		_state.Closed[_node] = true;
+		if (_node == _endNode)
+		{
+			_found = true;
+			break;
+		}
+
+		const int _x = _node / SizeY;
+		const int _y = _node % SizeY;
+		const int _parent = _state.Parent[_node];
+		if (_parent == INDEX_NONE || JumpStop[_node] || JumpStop[_parent])
+		{
+			//	No pruning : jump along every grid edge of a regular cell, take the graph edges of a jump stop as they are
+			for (int e = _graph.NeighborBegin(_node); e < _graph.NeighborEnd(_node); ++e)
+			{
+				const int _next = _graph.Neighbors[e];
+				if (JumpStop[_node])
+					_relax(_node, _next, _graph.EdgeCost(_node, _next));
+				else
+					_relaxJump(_node, _x, _y, _next / SizeY - _x, _next % SizeY - _y);
+			}
+			continue;
+		}
+
+		const int _dx = FMath::Sign(_x - _parent / SizeY);
+		const int _dy = FMath::Sign(_y - _parent % SizeY);
+		if (_dx && _dy)							//	Diagonal : natural neighbors + forced ones behind blocked sides
+		{
+			_relaxJump(_node, _x, _y, _dx, 0);
+			_relaxJump(_node, _x, _y, 0, _dy);
+			_relaxJump(_node, _x, _y, _dx, _dy);
+			if (!IsOpen(_x - _dx, _y) && IsOpen(_x - _dx, _y + _dy))
+				_relaxJump(_node, _x, _y, -_dx, _dy);
+			if (!IsOpen(_x, _y - _dy) && IsOpen(_x + _dx, _y - _dy))
+				_relaxJump(_node, _x, _y, _dx, -_dy);
+		}
+		else if (_dx)							//	Straight along X
+		{
+			_relaxJump(_node, _x, _y, _dx, 0);
+			if (!IsOpen(_x, _y + 1) && IsOpen(_x + _dx, _y + 1))
+				_relaxJump(_node, _x, _y, _dx, 1);
+			if (!IsOpen(_x, _y - 1) && IsOpen(_x + _dx, _y - 1))
+				_relaxJump(_node, _x, _y, _dx, -1);
+		}
+		else									//	Straight along Y
+		{
+			_relaxJump(_node, _x, _y, 0, _dy);
+			if (!IsOpen(_x + 1, _y) && IsOpen(_x + 1, _y + _dy))
+				_relaxJump(_node, _x, _y, 1, _dy);
+			if (!IsOpen(_x - 1, _y) && IsOpen(_x - 1, _y + _dy))
+				_relaxJump(_node, _x, _y, -1, _dy);
+		}
+	}
+	if (!_found) return false;
+
+	TArray<int> _jumpPoints = { };
+	for (int _node = _endNode; _node != _startNode; _node = _state.Parent[_node])
+		_jumpPoints.Add(_node);
+	_jumpPoints.Add(_startNode);
+	Algo::Reverse(_jumpPoints);
+
+	//	Fill the cells skipped by the jumps (runs are straight or diagonal lines)
+	_outPath.Add(_startNode);
+	const int _jumpMax = _jumpPoints.Num();
+	for (int i = 1; i < _jumpMax; ++i)
+	{
+		const int _from = _jumpPoints[i - 1];
+		const int _to = _jumpPoints[i];
+		if (_graph.FindEdge(_from, _to) != INDEX_NONE)
+		{
+			_outPath.Add(_to);
+			continue;
+		}
+
+		int _x = _from / SizeY, _y = _from % SizeY;
+		const int _toX = _to / SizeY, _toY = _to % SizeY;
+		const int _dx = FMath::Sign(_toX - _x), _dy = FMath::Sign(_toY - _y);
+		while (_x != _toX || _y != _toY)
+		{
+			if (_x != _toX) _x += _dx;
+			if (_y != _toY) _y += _dy;
+			_outPath.Add(CellIndex(_x, _y));
+		}
+	}
+	return true;
+}
+
+bool FNavigationJumpPointGrid::HasForcedNeighbor(const int _x, const int _y, const int _dx, const int _dy) const
+{
+	if (_dx && _dy)
+		return (!IsOpen(_x - _dx, _y) && IsOpen(_x - _dx, _y + _dy)) || (!IsOpen(_x, _y - _dy) && IsOpen(_x + _dx, _y - _dy));
+	if (_dx)
+		return (!IsOpen(_x, _y + 1) && IsOpen(_x + _dx, _y + 1)) || (!IsOpen(_x, _y - 1) && IsOpen(_x + _dx, _y - 1));
+	return (!IsOpen(_x + 1, _y) && IsOpen(_x + 1, _y + _dy)) || (!IsOpen(_x - 1, _y) && IsOpen(_x - 1, _y + _dy));
+}
+
+int FNavigationJumpPointGrid::Jump(int _x, int _y, const int _dx, const int _dy, const int _endNode) const
+{
+	while (true)
+	{
+		_x += _dx;
+		_y += _dy;
+		if (!IsOpen(_x, _y)) return INDEX_NONE;
+
+		const int _cell = CellIndex(_x, _y);
+		if (_cell == _endNode || JumpStop[_cell] || HasForcedNeighbor(_x, _y, _dx, _dy))
+			return _cell;
+		//	Diagonal runs stop where a straight run from the cell finds a jump point
+		if (_dx && _dy && (Jump(_x, _y, _dx, 0, _endNode) != INDEX_NONE || Jump(_x, _y, 0, _dy, _endNode) != INDEX_NONE))
+			return _cell;
+	}
+}
+#pragma endregion
@@ -0,0 +1,124 @@
+#include "NavigationLandmarks.h"
+
+#include "NavigationGraph.h"
+#include "NavigationSearch.h"
+
+namespace NavigationLandmarks
+{
+	//	Cost of the cheapest path from _source to every Node (from every Node to _source if _reverse), UE_MAX_FLT if unreachable
+	void ComputeCosts(const FNavigationGraph& _graph, const int _source, const bool _reverse, FNavigationNodeHeap& _openList, TArray<float>& _outCosts)
+	{
+		const int _max = _graph.NodeCount();
+		_outCosts.Init(UE_MAX_FLT, _max);
+		_openList.Reset(_max);
+		_outCosts[_source] = 0;
+		_openList.Push(_source, 0);
+		while (!_openList.IsEmpty())
+		{
+			const int _node = _openList.Pop();
+			const float _cost = _outCosts[_node];
+			const int _end = _reverse ? _graph.ReverseNeighborEnd(_node) : _graph.NeighborEnd(_node);
+			for (int e = _reverse ? _graph.ReverseNeighborBegin(_node) : _graph.NeighborBegin(_node); e < _end; ++e)
+			{
+				const int _next = _reverse ? _graph.ReverseNeighbors[e] : _graph.Neighbors[e];
+				const float _nextCost = _cost + _graph.EdgeCost(_node, _next);
+				if (_nextCost >= _outCosts[_next]) continue;
+
+				_outCosts[_next] = _nextCost;
+				_openList.Push(_next, _nextCost);
+			}
+		}
+	}
+
+	//	Reachable Node with the highest cost, INDEX_NONE if every reachable Node costs 0
+	int FindFarthestNode(const FNavigationGraph& _graph, const TArray<float>& _costs)
+	{
+		int _node = INDEX_NONE;
+		float _best = 0;
+		const int _max = _graph.NodeCount();
+		for (int i = 0; i < _max; ++i)
+		{
+			if (_costs[i] <= _best || _costs[i] >= UE_MAX_FLT) continue;
+			_best = _costs[i];
+			_node = i;
+		}
+		return _node;
+	}
+
+	FORCEINLINE uint16 Quantize(const float _cost, const float _step)
+	{
+		if (_cost >= UE_MAX_FLT) return FNavigationLandmarks::Unreachable;
+		return static_cast<uint16>(FMath::Min(FMath::FloorToInt(_cost / _step), FNavigationLandmarks::Unreachable - 1));
+	}
+}
+
+void FNavigationLandmarks::Build(const FNavigationGraph& _graph, const int _count)
+{
+	using namespace NavigationLandmarks;
+	Count = 0;
+	Step = 1;
+	IsSymmetric = true;
+	IsApproximate = false;
+	Nodes = { };
+	FromCosts = { };
+	ToCosts = { };
+	Tables = nullptr;
+
+	const int _max = _graph.NodeCount();
+	int _next = INDEX_NONE;
+	for (int i = 0; i < _max && _next == INDEX_NONE; ++i)
+		if (_graph.NeighborEnd(i) > _graph.NeighborBegin(i))
+			_next = i;
+	if (_count <= 0 || _next == INDEX_NONE) return;		//	No edge : nothing to estimate
+
+	const TSharedRef<FNavigationLandmarkTables, ESPMode::ThreadSafe> _tables = MakeShared<FNavigationLandmarkTables, ESPMode::ThreadSafe>();
+	TArray<int>& _nodes = _tables->Nodes;
+	TArray<uint16>& _fromCosts = _tables->FromCosts;
+	TArray<uint16>& _toCosts = _tables->ToCosts;
+	IsSymmetric = _graph.IsSymmetric;		//	Edge costs only depend on the distance : same cost both ways
+	FNavigationNodeHeap _openList;
+	TArray<TArray<float>> _from = { };
+	TArray<TArray<float>> _to = { };
+	TArray<float> _closest = { };		//	Cost from the closest landmark
+	ComputeCosts(_graph, _next, false, _openList, _closest);
+	_next = FindFarthestNode(_graph, _closest);			//	First landmark on the border of the island of the seed
+
+	while (_next != INDEX_NONE && _nodes.Num() < _count)
+	{
+		_nodes.Add(_next);
+		TArray<float>& _landmarkFrom = _from.AddDefaulted_GetRef();
+		ComputeCosts(_graph, _next, false, _openList, _landmarkFrom);
+		if (!IsSymmetric)
+			ComputeCosts(_graph, _next, true, _openList, _to.AddDefaulted_GetRef());
+
+		if (_nodes.Num() == 1)
+			_closest = _landmarkFrom;
+		for (int i = 0; i < _max; ++i)
+			_closest[i] = FMath::Min(_closest[i], _landmarkFrom[i]);
+		_next = FindFarthestNode(_graph, _closest);		//	Farthest from all the landmarks (other islands keep the distance estimate)
+	}
+
+	float _maxCost = 0;
+	for (const TArray<TArray<float>>* _table : { &_from, &_to })
+		for (const TArray<float>& _costs : *_table)
+			for (const float _cost : _costs)
+				if (_cost < UE_MAX_FLT)
+					_maxCost = FMath::Max(_maxCost, _cost);
+
+	Count = _nodes.Num();
+	Step = FMath::Max(_maxCost / (Unreachable - 1), UE_KINDA_SMALL_NUMBER);
+	_fromCosts.SetNumUninitialized(_max * Count);
+	_toCosts.SetNumUninitialized(IsSymmetric ? 0 : _max * Count);
+	for (int i = 0; i < _max; ++i)
+		for (int l = 0; l < Count; ++l)
+		{
+			_fromCosts[i * Count + l] = Quantize(_from[l][i], Step);
+			if (!IsSymmetric)
+				_toCosts[i * Count + l] = Quantize(_to[l][i], Step);
+		}
+
+	Nodes = _nodes;
+	FromCosts = _fromCosts;
+	ToCosts = _toCosts;
+	Tables = _tables;
+}
@@ -1,235 +1,1289 @@
 #include "NavigationMesh.h"
 
+#include "Async/Async.h"
+#include "Components/PrimitiveComponent.h"
+#include "EngineUtils.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+
 #if WITH_EDITOR
-#include "Kismet/KismetSystemLibrary.h"
+#include "NavigationNodeLinker.h"
 #endif
 
 #define LOG(_msg, ...) UE_LOG(LogTemp, Warning, TEXT(_msg), ##__VA_ARGS__)
 
 ANavigationMesh::ANavigationMesh()
 {
-	PrimaryActorTick.bCanEverTick = false;
+	PrimaryActorTick.bCanEverTick = true;			//	Tile streaming (enabled on BeginPlay if UseTiles) and debug
+	PrimaryActorTick.bStartWithTickEnabled = false;
 	RootComponent = CreateDefaultSubobject<USceneComponent>("Root Component");
 
 #if WITH_EDITOR
 	Billboard = CreateDefaultSubobject<UBillboardComponent>("Billboard");
 	Billboard->SetupAttachment(RootComponent);
-	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = true;
 #endif
 }
 
 UNavigationNode* ANavigationMesh::GetClosestNode(const FVector& _worldLocation)
 {
-	UNavigationNode* _node = nullptr;
-	float _last = UE_MAX_FLT;
-	
-	const int& _max = NavigationNodes.Num();
-	for (int i = 0; i < _max; ++i)
+	return GetNavigationNode(GetClosestNodeIndex(_worldLocation));
+}
+int ANavigationMesh::GetClosestNodeIndex(const FVector& _worldLocation)
+{
+	const FNavigationGraphPtr& _graph = GetNavigationGraph();
+	return _graph ? _graph->FindClosestNode(_worldLocation, NavMeshSettings.ClosestNodeSearchRange) : INDEX_NONE;
+}
+bool ANavigationMesh::NavigationRaycast(const FVector& _start, const FVector& _end, FNavigationRaycastHit& _outHit)
+{
+	const FNavigationGraphPtr& _graph = GetNavigationGraph();
+	if (!_graph)
 	{
-		UNavigationNode* _current = NavigationNodes[i];
-		if (!_current || !_current->IsNodeAccessible()) continue;
-		
-		const float& _dist = FVector::Dist(_current->NodeLocation(), _worldLocation);
-		if (_dist < _last)
+		_outHit = FNavigationRaycastHit();
+		_outHit.IsHit = true;
+		_outHit.Fraction = 0;
+		_outHit.Location = _start;
+		return false;
+	}
+	return FNavigationRaycast::Raycast(*_graph, _start, _end, GetBlockedNodes().Get(), _outHit);
+}
+
+const FNavigationGraphPtr& ANavigationMesh::GetNavigationGraph()
+{
+	if (!NavigationGraph)
+		CompileNavigationGraph();
+	return NavigationGraph;
+}
+void ANavigationMesh::CompileNavigationGraph()
+{
+	IsLoadingBakedGraph = false;		//	Graph needed now : a pending asynchronous load is dropped
+	if (IsNavigationGraphBaked())
+	{
+		if (const TSharedPtr<FNavigationGraph, ESPMode::ThreadSafe> _graph = LoadBakedNavigationGraph())
 		{
-			_last = _dist;
-			_node = _current;
+			SetNavigationGraph(_graph.ToSharedRef());
+			return;
 		}
+		DropInvalidBakedNavigationGraph();		//	Not baked anymore : compiled from the Nodes below
 	}
-	
-	return _node;
+	SetNavigationGraph(FNavigationGraph::Compile(NavigationNodes, GetCompileLayout()));		//	Landmarks are built on a worker thread
+}
+void ANavigationMesh::SetNavigationGraph(const TSharedRef<FNavigationGraph, ESPMode::ThreadSafe>& _graph)
+{
+	const FNavigationGraphPtr _previousGraph = NavigationGraph;
+	_graph->Version = ++NavigationVersion;
+	if (_previousGraph && _previousGraph->NodeCount() == _graph->NodeCount())
+	{
+		FNavigationGraph::FindChangedNodes(*_previousGraph, *_graph, _graph->ChangedNodes);
+		_graph->HasChangedNodes = true;
+	}
+	UpdateNavigationLandmarks(*_graph, _previousGraph);
+	NavigationGraph = _graph;		//	Searches still running on the previous snapshot keep their own reference
+	Obstacles.SetGraph(NavigationGraph);
+	UpdateNavigationHierarchy(_previousGraph);
+	UpdateNavigationJumpPointGrid();
+	if (GetCompileLandmarkCount() > 0 && (!NavigationGraph->Landmarks.IsBuilt() || NavigationGraph->Landmarks.IsApproximate))
+		BuildNavigationLandmarksAsync();
+}
+void ANavigationMesh::UpdateNavigationLandmarks(FNavigationGraph& _graph, const FNavigationGraphPtr& _previousGraph) const
+{
+	if (GetCompileLandmarkCount() <= 0 || _graph.Landmarks.IsBuilt()) return;		//	Not used, or baked with the graph
+	if (!_previousGraph || !_previousGraph->Landmarks.Tables || _previousGraph->NodeCount() != _graph.NodeCount()) return;		//	Tables of a baked file are not shared
+
+	_graph.Landmarks = _previousGraph->Landmarks;		//	Tables shared, not copied
+	if (!_graph.HasChangedNodes || !_graph.ChangedNodes.IsEmpty())
+		_graph.Landmarks.IsApproximate = true;			//	Patch, Node Linker... : costs changed around the changed Nodes
+}
+void ANavigationMesh::BuildNavigationLandmarksAsync()
+{
+	if (IsBuildingLandmarks || !NavigationGraph) return;		//	Started again for the latest graph when the running build is done
+	IsBuildingLandmarks = true;
+	Async(EAsyncExecution::ThreadPool, [_mesh = TWeakObjectPtr<ANavigationMesh>(this), _graph = NavigationGraph, _count = GetCompileLandmarkCount()]()
+	{
+		FNavigationLandmarks _landmarks;
+		_landmarks.Build(*_graph, _count);
+		AsyncTask(ENamedThreads::GameThread, [_mesh, _graph, _landmarks]()
+		{
+			if (_mesh.IsValid())
+				_mesh->OnNavigationLandmarksBuilt(_graph, _landmarks);
+		});
+	});
+}
+void ANavigationMesh::OnNavigationLandmarksBuilt(const FNavigationGraphPtr& _graph, const FNavigationLandmarks& _landmarks)
+{
+	IsBuildingLandmarks = false;
+	if (GetCompileLandmarkCount() <= 0 || !NavigationGraph || !_landmarks.IsBuilt()) return;
+
+	if (_graph == NavigationGraph)
+	{
+		SetNavigationGraph(FNavigationGraph::WithLandmarks(NavigationGraph.ToSharedRef(), _landmarks));		//	Same Nodes and edges, exact tables
+		return;
+	}
+	if (!NavigationGraph->Landmarks.IsBuilt() && _graph->NodeCount() == NavigationGraph->NodeCount())
+	{
+		FNavigationLandmarks _approximate = _landmarks;		//	Graph changed during the build : better than no table until the next build
+		_approximate.IsApproximate = true;
+		SetNavigationGraph(FNavigationGraph::WithLandmarks(NavigationGraph.ToSharedRef(), _approximate));		//	Builds again
+		return;
+	}
+	if (!NavigationGraph->Landmarks.IsBuilt() || NavigationGraph->Landmarks.IsApproximate)
+		BuildNavigationLandmarksAsync();
+}
+FNavigationGridLayout ANavigationMesh::GetCompileLayout() const
+{
+	if (GridLayout.Gap <= 0)			//	Mesh generated before the layout was saved
+		return FNavigationGridLayout(GetActorLocation(), NavMeshSettings.NavigationGridGap, 0, 0, false);
+	return GridLayout;
+}
+int ANavigationMesh::GetCompileLandmarkCount() const
+{
+	const bool _useLandmarks = NavMeshSettings.Heuristic == ENavigationHeuristic::HeuristicLandmarks && !NavMeshSettings.UseTiles;		//	Tiles change the graph too often
+	return _useLandmarks ? NavMeshSettings.LandmarkCount : 0;
+}
+TSharedPtr<FNavigationGraph, ESPMode::ThreadSafe> ANavigationMesh::LoadBakedNavigationGraph() const
+{
+	return FNavigationGraph::LoadBakedFile(GetBakedGraphPath(), BakedGraphChecksum);
+}
+void ANavigationMesh::DropInvalidBakedNavigationGraph()
+{
+	UE_LOG(LogTemp, Error, TEXT("ERROR : Baked Navigation Mesh graph %s is missing or NOT valid, the Navigation Nodes are generated again (bake the Navigation Mesh again)"), *GetBakedGraphPath());
+
+	//	Only the Nodes of the Node Linkers were kept by the bake : the graph compiled until the generation is done only has them
+	NavigationNodes.Reset();
+	for (const TPair<int, UNavigationNode*>& _pair : BakedNodes)
+	{
+		if (!_pair.Value) continue;
+		if (_pair.Key >= NavigationNodes.Num())
+			NavigationNodes.SetNumZeroed(_pair.Key + 1);
+		NavigationNodes[_pair.Key] = _pair.Value;
+	}
+	ClearBakedNavigationGraph();
+
+	if (GetWorld() && GridLayout.Gap > 0 && !NavMeshSettings.UseTiles)
+		StartNavigationMeshGeneration(NavMeshSettings, GridLayout, 0, FOnNavigationMeshBuilt());		//	Compiles the graph once the Nodes are generated
+}
+void ANavigationMesh::LoadBakedNavigationGraphAsync()
+{
+	IsLoadingBakedGraph = true;
+	Async(EAsyncExecution::ThreadPool, [_mesh = TWeakObjectPtr<ANavigationMesh>(this), _path = GetBakedGraphPath(), _checksum = BakedGraphChecksum]()
+	{
+		const TSharedPtr<FNavigationGraph, ESPMode::ThreadSafe> _graph = FNavigationGraph::LoadBakedFile(_path, _checksum);
+		AsyncTask(ENamedThreads::GameThread, [_mesh, _graph]()
+		{
+			if (_mesh.IsValid())
+				_mesh->OnBakedNavigationGraphLoaded(_graph);
+		});
+	});
+}
+void ANavigationMesh::OnBakedNavigationGraphLoaded(const TSharedPtr<FNavigationGraph, ESPMode::ThreadSafe>& _graph)
+{
+	if (!IsLoadingBakedGraph) return;		//	Compiled synchronously in the meantime
+	IsLoadingBakedGraph = false;
+
+	if (!_graph)
+	{
+		DropInvalidBakedNavigationGraph();
+		CompileNavigationGraph();
+		return;
+	}
+	SetNavigationGraph(_graph.ToSharedRef());
+}
+FString ANavigationMesh::GetBakedGraphPath() const
+{
+	return FNavigationGraph::GetBakedFilePath(FPaths::ProjectContentDir(), GetTileMeshName());
+}
+void ANavigationMesh::ClearBakedNavigationGraph()
+{
+	HasBakedGraph = false;
+	BakedGraphChecksum = 0;
+	BakedNodes.Empty();
+}
+
+void ANavigationMesh::UpdateNavigationHierarchy(const FNavigationGraphPtr& _previousGraph)
+{
+	if (NavMeshSettings.SearchMode != ENavigationSearchMode::SearchHierarchical || !NavigationGraph)
+	{
+		NavigationHierarchy = nullptr;
+		return;
+	}
+
+	FNavigationSearch _scratch;
+	if (NavigationHierarchy && _previousGraph && NavigationGraph->HasChangedNodes && NavigationHierarchy->IsCompatible(*NavigationGraph, NavMeshSettings.HierarchyClusterSize))
+	{
+		const TArray<int>& _changedNodes = NavigationGraph->ChangedNodes;
+		if (_changedNodes.IsEmpty()) return;
+
+		const TSharedRef<FNavigationHierarchy, ESPMode::ThreadSafe> _hierarchy = MakeShared<FNavigationHierarchy, ESPMode::ThreadSafe>(*NavigationHierarchy);
+		_hierarchy->RebuildClusters(*NavigationGraph, _changedNodes, _scratch);
+		NavigationHierarchy = _hierarchy;
+		return;
+	}
+
+	const TSharedRef<FNavigationHierarchy, ESPMode::ThreadSafe> _hierarchy = MakeShared<FNavigationHierarchy, ESPMode::ThreadSafe>();
+	_hierarchy->Build(*NavigationGraph, NavMeshSettings.HierarchyClusterSize, _scratch);
+	NavigationHierarchy = _hierarchy;
+}
+
+void ANavigationMesh::UpdateNavigationJumpPointGrid()
+{
+	NavigationJumpPointGrid = nullptr;
+	if (!NavigationGraph || !NavigationGraph->SpatialIndex.IsSimpleGrid) return;
+
+	const TSharedRef<FNavigationJumpPointGrid, ESPMode::ThreadSafe> _jumpPointGrid = MakeShared<FNavigationJumpPointGrid, ESPMode::ThreadSafe>();
+	if (_jumpPointGrid->Build(*NavigationGraph))
+		NavigationJumpPointGrid = _jumpPointGrid;
+}
+
+FNavigationPathRequest ANavigationMesh::MakePathRequest(const int _startNode, const int _endNode)
+{
+	return MakePathRequest(_startNode, _endNode, NavMeshSettings.SearchMode);
+}
+FNavigationPathRequest ANavigationMesh::MakePathRequest(const int _startNode, const int _endNode, const ENavigationSearchMode _mode)
+{
+	FNavigationPathRequest _request;
+	_request.Graph = GetNavigationGraph();
+	_request.StartNode = _startNode;
+	_request.EndNode = _endNode;
+	_request.Mode = _mode;
+	_request.BlockedNodes = GetBlockedNodes();
+	if (_request.Mode == ENavigationSearchMode::SearchHierarchical)
+	{
+		_request.Hierarchy = NavigationHierarchy;
+		if (!_request.Hierarchy)
+			_request.Mode = ENavigationSearchMode::SearchAStar;
+	}
+	else if (_request.Mode == ENavigationSearchMode::SearchJumpPoint)
+	{
+		_request.JumpPointGrid = NavigationJumpPointGrid;
+		if (!_request.JumpPointGrid)		//	Complex mesh
+			_request.Mode = ENavigationSearchMode::SearchAStar;
+	}
+	return _request;
+}
+
+bool ANavigationMesh::IsOptimalSearchMode(const ENavigationSearchMode _mode) const
+{
+	if (_mode == ENavigationSearchMode::SearchHierarchical) return false;		//	Shortest path between cluster entrances only
+	return !NavigationGraph || !NavigationGraph->Landmarks.IsApproximate;		//	Tables of an older graph can overestimate
+}
+bool ANavigationMesh::FindCachedPath(const int _startNode, const int _endNode, const ENavigationSearchMode _mode, TArray<int>& _outPath)
+{
+	PathCache.SetCapacity(NavMeshSettings.PathCacheSize);
+	return PathCache.Find(GetNavigationVersion(), _mode, IsOptimalSearchMode(_mode), _startNode, _endNode, _outPath);
+}
+void ANavigationMesh::AddCachedPath(const uint32 _version, const ENavigationSearchMode _mode, const TArray<int>& _path)
+{
+	if (_version != GetNavigationVersion()) return;		//	Same version : the landmarks of the search are the current ones
+
+	PathCache.SetCapacity(NavMeshSettings.PathCacheSize);
+	PathCache.Add(_version, _mode, IsOptimalSearchMode(_mode), _path);
+}
+void ANavigationMesh::SmoothNodePath(FNavigationNodePath& _path)
+{
+	const FNavigationGraphPtr _graph = GetNavigationGraph();
+	if (!_graph) return;
+
+	PathSmoother.SetCapacity(NavMeshSettings.VisibilityCacheSize);
+	PathSmoother.SmoothPath(*_graph, GetNavigationVersion(), GetBlockedNodes().Get(), _path);
+}
+
+FNavigationFlowFieldPtr ANavigationMesh::AcquireFlowField(const int _targetNode, const FNavigationFlowFieldPtr& _previous)
+{
+	const FNavigationGraphPtr& _graph = GetNavigationGraph();
+	if (!_graph || !_graph->IsValidNode(_targetNode)) return nullptr;
+
+	const FNavigationBlockedNodesPtr& _blocked = GetBlockedNodes();
+	if (const TWeakPtr<const FNavigationFlowField, ESPMode::ThreadSafe>* _shared = FlowFields.Find(_targetNode))
+	{
+		const FNavigationFlowFieldPtr _field = _shared->Pin();
+		if (_field && _field->FieldGraph() == _graph && _field->FieldBlockedNodes() == _blocked)		//	Fields of an older graph or obstacle version are recomputed
+			return _field;
+	}
+
+	const TSharedRef<FNavigationFlowField, ESPMode::ThreadSafe> _field = MakeShared<FNavigationFlowField, ESPMode::ThreadSafe>();
+	if (!_previous || _previous->FieldGraph() != _graph || _previous->FieldBlockedNodes() != _blocked || !_field->Retarget(*_previous, _targetNode))
+		_field->Build(_graph, _targetNode, _blocked);
+
+	for (auto _it = FlowFields.CreateIterator(); _it; ++_it)		//	Forget the released fields
+		if (!_it.Value().IsValid())
+			_it.RemoveCurrent();
+	FlowFields.Add(_targetNode, _field);
+	return _field;
+}
+
+void ANavigationMesh::NodePassedBy(const int _node, AActor* _actor) const
+{
+	if (UNavigationNode* _navigationNode = GetNavigationNode(_node))
+		_navigationNode->PassedBy(_actor);
+}
+
+int ANavigationMesh::AddNavigationObstacle(const FNavigationObstacleShape& _shape)
+{
+	GetNavigationGraph();			//	Obstacles are stamped on the compiled graph
+	return Obstacles.Add(_shape);
+}
+void ANavigationMesh::UpdateNavigationObstacle(const int _id, const FNavigationObstacleShape& _shape)
+{
+	Obstacles.Update(_id, _shape);
+}
+void ANavigationMesh::RemoveNavigationObstacle(const int _id)
+{
+	Obstacles.Remove(_id);
+}
+
+void ANavigationMesh::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (!NavMeshSettings.UseTiles) return;
+
+	NavigationNodes.Empty();			//	Nodes only come from the streamed tiles
+	GridLayout = FNavigationGridLayout(GetActorLocation(), NavMeshSettings.NavigationGridGap, 0, 0, false);
+	CompileNavigationGraph();
+	TileStreamingTimer = 0;
+	SetActorTickEnabled(true);
+}
+void ANavigationMesh::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	CancelTileRequests();
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void ANavigationMesh::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	if (NavMeshSettings.UseTiles && GetWorld()->IsGameWorld())
+	{
+		TileStreamingTimer -= DeltaTime;
+		if (TileStreamingTimer <= 0)
+		{
+			TileStreamingTimer = NavMeshSettings.TileStreamingInterval;
+			UpdateTileStreaming();
+		}
+		if (TileGraphDirty)			//	One compilation for all the tiles loaded or evicted this frame
+		{
+			TileGraphDirty = false;
+			CompileNavigationGraph();
+		}
+	}
+	if (!DirtyBounds.IsEmpty() && NavMeshSettings.AutoRebuildDirtyRegions && !Generator)
+	{
+		DirtyRebuildTimer -= DeltaTime;
+		if (DirtyRebuildTimer <= 0)
+			RebuildDirtyRegions();
+	}
+
 	#if WITH_EDITOR
 	DrawNavigationMeshDebug();
 	#endif
 }
 
+void ANavigationMesh::PostLoad()
+{
+	Super::PostLoad();
+
+	UpdateNodesIndex();		//	Meshes saved before Nodes had an index
+	if (IsNavigationGraphBaked())
+		LoadBakedNavigationGraphAsync();	//	Mapped off the game thread, the first search before it is done maps it synchronously
+	else
+		CompileNavigationGraph();
+}
+
+void ANavigationMesh::UpdateNodesIndex()
+{
+	const int& _max = NavigationNodes.Num();
+	for (int i = 0; i < _max; ++i)
+		if (UNavigationNode* _node = NavigationNodes[i])
+			_node->SetNodeIndex(i);
+}
+
+void ANavigationMesh::Destroyed()
+{
+	CancelNavigationMeshGeneration();
+	CancelTileRequests();
+#if WITH_EDITOR
+	UnbindLevelActorEvents();
+#endif
+
+	Super::Destroyed();
+}
+void ANavigationMesh::BeginDestroy()
+{
+	if (Generator)			//	Traces use the world : wait for them before it goes away
+	{
+		Generator->Cancel();
+		Generator->Wait();
+		Generator = nullptr;
+	}
+	for (const TPair<FIntPoint, FNavigationMeshGeneratorPtr>& _tileGenerator : TileGenerators)
+	{
+		_tileGenerator.Value->Cancel();
+		_tileGenerator.Value->Wait();
+	}
+	TileGenerators.Empty();
 #if WITH_EDITOR
+	UnbindLevelActorEvents();
+#endif
+
+	Super::BeginDestroy();
+}
+
+#pragma region Navigation Mesh Build
+bool ANavigationMesh::BuildNavigationMesh(const FBox& _bounds, const bool _isSimpleGrid, const FOnNavigationMeshBuilt& _onCompleted)
+{
+	FNavigationMeshSettings _settings = NavMeshSettings;
+	FVector _origin = GetActorLocation();
+	if (_bounds.IsValid)
+	{
+		const FVector& _size = _bounds.GetSize();
+		_origin = FVector(_bounds.Min.X, _bounds.Min.Y, _bounds.Max.Z);
+		_settings.NavigationGridSizeX = FMath::FloorToInt(_size.X / _settings.NavigationGridGap) + 1;
+		_settings.NavigationGridSizeY = FMath::FloorToInt(_size.Y / _settings.NavigationGridGap) + 1;
+		_settings.NavigationGridHeight = FMath::Max(_size.Z, 1.0f);
+	}
+
+	const FNavigationGridLayout _layout = FNavigationGridLayout(_origin, _settings.NavigationGridGap, _settings.NavigationGridSizeX, _settings.NavigationGridSizeY, _isSimpleGrid);
+	const int64 _memoryBudget = static_cast<int64>(NavMeshSettings.RuntimeMemoryBudgetMB) * 1024 * 1024;
+	return StartNavigationMeshGeneration(_settings, _layout, _memoryBudget, _onCompleted);
+}
+void ANavigationMesh::CancelNavigationMeshGeneration()
+{
+	if (!Generator) return;
+
+	Generator->Cancel();
+	Generator = nullptr;
+	if (RebuildingBounds.IsValid)			//	Traced again by the next rebuild
+	{
+		DirtyBounds.Add(RebuildingBounds);
+		RebuildingBounds.Init();
+	}
+	const FOnNavigationMeshBuilt _onBuilt = OnBuilt;
+	OnBuilt.Unbind();
+	_onBuilt.ExecuteIfBound(false);
+}
+
+void ANavigationMesh::MarkDirtyBounds(const FBox& _bounds)
+{
+	if (!_bounds.IsValid) return;
+
+	DirtyBounds.Add(_bounds);
+	DirtyRebuildTimer = NavMeshSettings.DirtyRebuildDelay;		//	Wait for the edits to settle (e.g. an actor being dragged)
+	SetActorTickEnabled(true);
+}
+void ANavigationMesh::RebuildDirtyRegions()
+{
+	if (DirtyBounds.IsEmpty() || Generator) return;
+	if (NavMeshSettings.UseTiles || NavigationNodes.IsEmpty() || GridLayout.Gap <= 0 || GridLayout.SizeX <= 0 || GridLayout.SizeY <= 0)
+	{
+		DirtyBounds.Reset();		//	Nothing generated to patch (tiles are baked again instead, baked graphs are unbaked first)
+		return;
+	}
+
+	//	Region of the first dirty box and of all the boxes overlapping it
+	FBox _region = DirtyBounds.Pop();
+	for (bool _isMerged = true; _isMerged;)
+	{
+		_isMerged = false;
+		for (int i = DirtyBounds.Num() - 1; i >= 0; --i)
+		{
+			if (!DirtyBounds[i].Intersect(_region)) continue;
+			_region += DirtyBounds[i];
+			DirtyBounds.RemoveAtSwap(i);
+			_isMerged = true;
+		}
+	}
+
+	//	Cells whose traces can be changed by the region : obstacle avoidance and Agent clearance around it
+	const float _margin = NavMeshSettings.ObstacleAvoidanceSize + NavMeshSettings.AgentWidth + GridLayout.Gap;
+	const FBox& _traced = _region.ExpandBy(FVector(_margin, _margin, 0));
+	const FIntPoint& _min = GetGridCell(_traced.Min);
+	const FIntPoint& _max = GetGridCell(_traced.Max);
+	const FIntPoint _first = FIntPoint(FMath::Max(_min.X, 0), FMath::Max(_min.Y, 0));
+	const FIntPoint _last = FIntPoint(FMath::Min(_max.X, GridLayout.SizeX - 1), FMath::Min(_max.Y, GridLayout.SizeY - 1));
+	if (_first.X > _last.X || _first.Y > _last.Y)		//	Out of the grid
+	{
+		RebuildDirtyRegions();
+		return;
+	}
+
+	const FNavigationGridLayout _layout = FNavigationGridLayout(GridLayout.Origin + FVector(_first.X, _first.Y, 0) * GridLayout.Gap, GridLayout.Gap, _last.X - _first.X + 1, _last.Y - _first.Y + 1, GridLayout.IsSimpleGrid);
+	Generator = MakeShared<FNavigationMeshGenerator, ESPMode::ThreadSafe>(GetWorld(), NavMeshSettings, _layout);
+	RebuildingBounds = _region;
+	Generator->Start([_mesh = TWeakObjectPtr<ANavigationMesh>(this), _generator = TWeakPtr<FNavigationMeshGenerator, ESPMode::ThreadSafe>(Generator), _first]()
+	{
+		if (_mesh.IsValid() && _mesh->Generator && _mesh->Generator == _generator.Pin())		//	Not restarted since
+			_mesh->CompleteDirtyRegionRebuild(_first);
+	});
+}
+#pragma endregion
+
 #pragma region Navigation Mesh Init 
-void ANavigationMesh::GenerateNavigationMeshSimple()
+bool ANavigationMesh::StartNavigationMeshGeneration(const FNavigationMeshSettings& _settings, const FNavigationGridLayout& _layout, const int64 _memoryBudget, const FOnNavigationMeshBuilt& _onCompleted)
 {
-	if (NavMeshSettings.ObstacleLayers.IsEmpty())
+	if (_settings.ObstacleLayers.IsEmpty())
 		UE_LOG(LogTemp, Warning, TEXT("WARNING : Navigation Mesh Settings -> Obstacle Layers is Empty ! Obstacle are ignored"));
-	if (NavMeshSettings.GroundLayers.IsEmpty())
+	if (_settings.GroundLayers.IsEmpty())
 	{
 		UE_LOG(LogTemp, Error, TEXT("ERROR : Navigation Mesh Settings -> Ground Layers is Empty ! Node can NOT be created"));		
+		return false;
+	}
+	if (NavMeshSettings.UseTiles)
+	{
+		UE_LOG(LogTemp, Error, TEXT("ERROR : Navigation Mesh uses tiles, they are streamed or baked (Bake Navigation Tiles) instead of generated at once"));
+		return false;
+	}
+	//	Simple grids know their Node count up front, Complex grids are checked by the generator once the ground is traced
+	const int64 _nodeCount = static_cast<int64>(_layout.SizeX) * _layout.SizeY;
+	if (_memoryBudget > 0 && _layout.IsSimpleGrid && _nodeCount * FNavigationMeshGenerator::EstimateNodeMemory() > _memoryBudget)
+	{
+		UE_LOG(LogTemp, Error, TEXT("ERROR : Navigation Mesh build of %lld Nodes is over the memory budget (%lld bytes)"), _nodeCount, _memoryBudget);
+		return false;
+	}
+
+	CancelNavigationMeshGeneration();
+	DirtyBounds.Reset();					//	Everything is traced again
+	RebuildingBounds.Init();
+	Generator = MakeShared<FNavigationMeshGenerator, ESPMode::ThreadSafe>(GetWorld(), _settings, _layout, _memoryBudget);
+	OnBuilt = _onCompleted;
+	Generator->Start([_mesh = TWeakObjectPtr<ANavigationMesh>(this), _generator = TWeakPtr<FNavigationMeshGenerator, ESPMode::ThreadSafe>(Generator)]()
+	{
+		if (_mesh.IsValid() && _mesh->Generator && _mesh->Generator == _generator.Pin())		//	Not restarted since
+			_mesh->CompleteNavigationMeshGeneration();
+	});
+	return true;
+}
+void ANavigationMesh::CompleteNavigationMeshGeneration()
+{
+	const FNavigationMeshGeneratorPtr _generator = Generator;
+	const FOnNavigationMeshBuilt _onBuilt = OnBuilt;
+	Generator = nullptr;
+	OnBuilt.Unbind();
+
+	if (_generator->IsOverMemoryBudget())
+	{
+		UE_LOG(LogTemp, Error, TEXT("ERROR : Navigation Mesh build is over the memory budget, the current Navigation Mesh is kept"));
+		_onBuilt.ExecuteIfBound(false);
 		return;
 	}
-	
+
+	ClearBakedNavigationGraph();			//	New Nodes to bake again
 	NavigationNodes.Empty();
-	const FVector& _location = GetActorLocation();
-	for (int x = 0; x < NavMeshSettings.NavigationGridSizeX; ++x)
+	GridLayout = _generator->GenerationLayout();
+	const TArray<FNavigationGenerationSample>& _samples = _generator->GenerationSamples();
+	NavigationNodes.Reserve(_samples.Num());
+	for (const FNavigationGenerationSample& _sample : _samples)
 	{
-		for (int y = 0; y < NavMeshSettings.NavigationGridSizeY; ++y)
+		UNavigationNode* _node = NewObject<UNavigationNode>(this);
+		_node->InitializeNavigationNode(_sample.Location, _sample.IsAccessible);
+		_node->SetNodeIndex(NavigationNodes.Add(_node));
+	}
+
+	GenerateNodesNeighbors(*_generator);
+	UE_LOG(LogTemp, Log, TEXT("Navigation Mesh generated : %d Nodes in %.2fs"), NavigationNodes.Num(), _generator->ElapsedTime());
+
+	CompileNavigationGraph();		//	Swaps the graph snapshot : queries already running keep the previous one
+	OnNavMeshGeneration.Broadcast();	//	Node Linkers find their Nodes in the new graph and recompile it with their edges
+#if WITH_EDITOR
+	CacheLayerActorBounds();
+#endif
+	_onBuilt.ExecuteIfBound(true);
+}
+void ANavigationMesh::GenerateNodesNeighbors(const FNavigationMeshGenerator& _generator)
+{
+	const int _max = NavigationNodes.Num();
+	for (int i = 0; i < _max; ++i)
+	{
+		UNavigationNode* _node = NavigationNodes[i];
+		const int _end = _generator.SampleNeighborEnd(i);
+		for (int n = _generator.SampleNeighborBegin(i); n < _end; ++n)
+			_node->AddNeighbor(NavigationNodes[_generator.SampleNeighbor(n)]);
+	}
+}
+#pragma endregion
+
+#pragma region Dirty Regions
+void ANavigationMesh::CompleteDirtyRegionRebuild(const FIntPoint& _first)
+{
+	const FNavigationMeshGeneratorPtr _generator = Generator;
+	Generator = nullptr;
+	RebuildingBounds.Init();
+
+	const FNavigationGridLayout& _region = _generator->GenerationLayout();
+	if (GridLayout.IsSimpleGrid)
+		PatchDirtyRegionSimple(_first, _region, _generator->GenerationSamples());
+	else
+		PatchDirtyRegionComplex(_first, _region, _generator->GenerationSamples());
+	const int _ring = FMath::CeilToInt((NavMeshSettings.NavigationGridGap + NavMeshSettings.AgentExtraWalkStep) / GridLayout.Gap);
+	RestoreNodeLinks(FIntRect(_first - FIntPoint(_ring, _ring), _first + FIntPoint(_region.SizeX + _ring, _region.SizeY + _ring)));
+	UE_LOG(LogTemp, Log, TEXT("Navigation Mesh region rebuilt : %d x %d cells in %.2fs"), _region.SizeX, _region.SizeY, _generator->ElapsedTime());
+
+	CompileNavigationGraph();		//	Only the patched Nodes differ from the previous graph
+	RebuildDirtyRegions();			//	Next region, if any
+}
+
+void ANavigationMesh::PatchDirtyRegionSimple(const FIntPoint& _first, const FNavigationGridLayout& _region, const TArray<FNavigationGenerationSample>& _samples)
+{
+	const int _sizeX = GridLayout.SizeX;
+	const int _sizeY = GridLayout.SizeY;
+	if (NavigationNodes.Num() != _sizeX * _sizeY) return;
+
+	for (int x = 0; x < _region.SizeX; ++x)
+		for (int y = 0; y < _region.SizeY; ++y)
+		{
+			const FNavigationGenerationSample& _sample = _samples[x * _region.SizeY + y];
+			if (UNavigationNode* _node = NavigationNodes[(_first.X + x) * _sizeY + _first.Y + y])
+				_node->InitializeNavigationNode(_sample.Location, _sample.IsAccessible);
+		}
+
+	//	Edges of the region and of the ring of cells around it (same rule as the generation, 8 grid neighbors in walk range)
+	const float _range = NavMeshSettings.NavigationGridGap + NavMeshSettings.AgentExtraWalkStep;
+	const int _maxX = FMath::Min(_first.X + _region.SizeX, _sizeX - 1);
+	const int _maxY = FMath::Min(_first.Y + _region.SizeY, _sizeY - 1);
+	for (int x = FMath::Max(_first.X - 1, 0); x <= _maxX; ++x)
+		for (int y = FMath::Max(_first.Y - 1, 0); y <= _maxY; ++y)
 		{
-			const FVector& _nodeLocation = _location + FVector(x * NavMeshSettings.NavigationGridGap, y * NavMeshSettings.NavigationGridGap, 0);
+			UNavigationNode* _node = NavigationNodes[x * _sizeY + y];
+			if (!_node) continue;
 
-			UNavigationNode* _node = NewObject<UNavigationNode>(this);
-			_node->InitializeNavigationNodeSimple(_nodeLocation, NavMeshSettings);
-			NavigationNodes.Add(_node);
+			for (int nx = FMath::Max(x - 1, 0); nx <= FMath::Min(x + 1, _sizeX - 1); ++nx)
+				for (int ny = FMath::Max(y - 1, 0); ny <= FMath::Min(y + 1, _sizeY - 1); ++ny)
+				{
+					UNavigationNode* _neighbor = NavigationNodes[nx * _sizeY + ny];
+					if (!_neighbor || _neighbor == _node) continue;
+
+					if (_node->IsNodeAccessible() && _neighbor->IsNodeAccessible() && FVector::Dist(_node->NodeLocation(), _neighbor->NodeLocation()) <= _range)
+						_node->AddNeighbor(_neighbor);
+					else
+						_node->RemoveNeighbor(_neighbor);
+				}
 		}
-	}
+}
 
-	GenerateNodesNeighborsSimple();
+void ANavigationMesh::RestoreNodeLinks(const FIntRect& _patched)
+{
+	for (TActorIterator<ANavigationNodeLinker> _it(GetWorld()); _it; ++_it)
+	{
+		if (_it->GetNavigationMesh() != this) continue;
 
-	OnNavMeshGeneration.Broadcast();
+		const UNavigationNode* _nodeLeft = _it->GetNodeLeft();
+		const UNavigationNode* _nodeRight = _it->GetNodeRight();
+		if ((_nodeLeft && _patched.Contains(GetGridCell(_nodeLeft->NodeLocation()))) || (_nodeRight && _patched.Contains(GetGridCell(_nodeRight->NodeLocation()))))
+			_it->RestoreNodeLink();
+	}
 }
-void ANavigationMesh::GenerateNodesNeighborsSimple()
+
+void ANavigationMesh::PatchDirtyRegionComplex(const FIntPoint& _first, const FNavigationGridLayout& _region, const TArray<FNavigationGenerationSample>& _samples)
 {
-	const int& _max = NavigationNodes.Num();
-	const int& _maxX = NavMeshSettings.NavigationGridSizeX;
-	const int& _maxY = NavMeshSettings.NavigationGridSizeY;
-	for (int i = 0; i < _max; ++i)
+	const FIntRect _traced = FIntRect(_first, _first + FIntPoint(_region.SizeX, _region.SizeY));
+	auto _sortTopToBottom = [](const UNavigationNode& _a, const UNavigationNode& _b) { return _a.NodeLocation().Z > _b.NodeLocation().Z; };
+	auto _unlink = [](UNavigationNode* _node)			//	Edges both ways, Linker edges are added again by RestoreNodeLinks
 	{
-		if (UNavigationNode* _node = NavigationNodes[i])
+		for (UNavigationNode* _neighbor : _node->NodeNeighbors())
+			if (_neighbor)
+				_neighbor->RemoveNeighbor(_node);
+		_node->ClearNeighbors();
+	};
+
+	//	Current Nodes and new samples of each re-traced column
+	TMap<FIntPoint, TArray<UNavigationNode*>> _nodeColumns = { };
+	for (UNavigationNode* _node : NavigationNodes)
+		if (_node && _traced.Contains(GetGridCell(_node->NodeLocation())))
+			_nodeColumns.FindOrAdd(GetGridCell(_node->NodeLocation())).Add(_node);
+	TMap<FIntPoint, TArray<int>> _sampleColumns = { };
+	const int _sampleMax = _samples.Num();
+	for (int i = 0; i < _sampleMax; ++i)
+		_sampleColumns.FindOrAdd(GetGridCell(_samples[i].Location)).Add(i);
+
+	TArray<int> _createSamples = { };
+	for (int x = _traced.Min.X; x < _traced.Max.X; ++x)
+		for (int y = _traced.Min.Y; y < _traced.Max.Y; ++y)
 		{
-																		//	Those Conditions works with the NavMesh generation : Line X -> Generate All Y Node -> Go Next Line X...
-			const bool& _canRight = i % _maxY != _maxY - 1;				//	If i % MaxY == MaxY - 1 -> Means i is on the last element of the Y Line (on the Right Side, then can't go more to the Right)
-			const bool& _canLeft = i % _maxY != 0;						//	If i % MaxY == 0		-> Means i is in the first element of the Y Line (on the Left side, then can't go more to the Left) 
-			const bool& _canDown = i >= _maxY;							//	While i is NOT on the first Y Line	-> Can Go Down
-			const bool& _canTop = i < _maxX * _maxY - _maxY;			//	While i < Maximum Node - 1 Y Range	-> Can Top 
-
-			const int& _indexRight		= i + 1;
-			const int& _indexLeft		= i - 1;
-			const int& _indexTop		= i + _maxY;
-			const int& _indexTopRight	= i + 1 + _maxY;
-			const int& _indexTopLeft	= i - 1 + _maxY;
-			const int& _indexDown		= i - _maxY;
-			const int& _indexDownRight	= i + 1 - _maxY;
-			const int& _indexDownLeft	= i - 1 - _maxY;
-			const float& _range = NavMeshSettings.NavigationGridGap + NavMeshSettings.AgentExtraWalkStep;
-			
-			if (_canRight	&& CheckAgentCanWalkBetweenNodes(_node, NavigationNodes[_indexRight], _range))
-				_node->AddNeighbor(NavigationNodes[_indexRight]);
-			if (_canLeft	&& CheckAgentCanWalkBetweenNodes(_node, NavigationNodes[_indexLeft], _range))
-			 		_node->AddNeighbor(NavigationNodes[_indexLeft]);
-			
-			if (_canTop)
+			TArray<UNavigationNode*>* _nodes = _nodeColumns.Find(FIntPoint(x, y));
+			const TArray<int>* _columnSamples = _sampleColumns.Find(FIntPoint(x, y));
+			const int _nodeCount = _nodes ? _nodes->Num() : 0;
+			const int _sampleCount = _columnSamples ? _columnSamples->Num() : 0;
+			if (_nodes)
+				_nodes->Sort(_sortTopToBottom);			//	Samples are top to bottom already
+
+			for (int n = 0; n < FMath::Min(_nodeCount, _sampleCount); ++n)		//	Node objects are kept : Node Linkers stay bound
 			{
-				if (CheckAgentCanWalkBetweenNodes(_node, NavigationNodes[_indexTop], _range))
-					_node->AddNeighbor(NavigationNodes[_indexTop]);
-				if (_canRight	&& CheckAgentCanWalkBetweenNodes(_node, NavigationNodes[_indexTopRight], _range))
-					_node->AddNeighbor(NavigationNodes[_indexTopRight]);
-				if (_canLeft	&& CheckAgentCanWalkBetweenNodes(_node, NavigationNodes[_indexTopLeft], _range))
-					_node->AddNeighbor(NavigationNodes[_indexTopLeft]);
+				//	A kept Node can move to another floor : its old neighbors can be out of the cells checked by the edge pass
+				UNavigationNode* _node = (*_nodes)[n];
+				_unlink(_node);
+				const FNavigationGenerationSample& _sample = _samples[(*_columnSamples)[n]];
+				_node->InitializeNavigationNode(_sample.Location, _sample.IsAccessible);
 			}
-			if (_canDown)
+			for (int n = _sampleCount; n < _nodeCount; ++n)						//	Ground removed
 			{
-				if (CheckAgentCanWalkBetweenNodes(_node, NavigationNodes[_indexDown], _range))
-					_node->AddNeighbor(NavigationNodes[_indexDown]);
-				if (_canRight	&& CheckAgentCanWalkBetweenNodes(_node, NavigationNodes[_indexDownRight], _range))
-					_node->AddNeighbor(NavigationNodes[_indexDownRight]);
-				if (_canLeft	&& CheckAgentCanWalkBetweenNodes(_node, NavigationNodes[_indexDownLeft], _range))
-					_node->AddNeighbor(NavigationNodes[_indexDownLeft]);
+				UNavigationNode* _node = (*_nodes)[n];
+				_unlink(_node);
+				NavigationNodes[_node->NodeIndex()] = nullptr;
+				ReleaseNodeRange(FNavigationNodeRange(_node->NodeIndex(), 1));
 			}
+			for (int n = _nodeCount; n < _sampleCount; ++n)						//	Ground added
+				_createSamples.Add((*_columnSamples)[n]);
+		}
+	for (const int _sample : _createSamples)
+	{
+		const int _index = AllocateNodeRange(1);
+		UNavigationNode* _node = NewObject<UNavigationNode>(this);
+		_node->InitializeNavigationNode(_samples[_sample].Location, _samples[_sample].IsAccessible);
+		_node->SetNodeIndex(_index);
+		NavigationNodes[_index] = _node;
+	}
 
-			/*	Debug Condition
-			//	Can Right
-			// LOG("%d %s = %d", i, *FString("% GridSizeY"), i % GridSizeY);
-			// LOG("GridSizeY - 1 = %d", GridSizeY - 1)
-			// LOG("%d != %d : %s", i % GridSizeY, GridSizeY - 1, *FString(i % GridSizeY != GridSizeY - 1 ? "true" : "false"));
-			// LOG("-------------------------------------")
-
-			//	Can Left
-			// LOG("%d %s = %d", i, *FString("% GridSizeY"), i % GridSizeY)
-			// LOG("%s != 0 : %s", *FString("i % GridSizeY"), *FString(i % GridSizeY != 0 ? "true" : "false"));
-			// LOG("-------------------------------------")
-			
-			//	Can Down
-			//	LOG("i >= GridSizeY : %s", *FString(i >= GridSizeY ? "true" : "false"))
-			//	LOG("-------------------------------------")
-			
-			//	Can Top
-			//	LOG("i < GridSizeX * GridSizeY - GridSizeY : %s", *FString(i < GridSizeX * GridSizeY - GridSizeY ? "true" : "false"))
-			//	LOG("-------------------------------------")
-			*/
+	//	Edges of the Nodes of the region and of the columns in walk range around it, found with a spatial hash of cell size = range
+	const float _range = NavMeshSettings.NavigationGridGap + NavMeshSettings.AgentExtraWalkStep;
+	const int _ring = FMath::CeilToInt(_range / GridLayout.Gap);
+	const FIntRect _patched = FIntRect(_traced.Min - FIntPoint(_ring, _ring), _traced.Max + FIntPoint(_ring, _ring));
+	auto _getCell = [_range](const FVector& _location)
+	{
+		const FVector& _cell = _location / _range;
+		return FIntVector(FMath::FloorToInt(_cell.X), FMath::FloorToInt(_cell.Y), FMath::FloorToInt(_cell.Z));
+	};
+	TArray<UNavigationNode*> _patchNodes = { };
+	TMap<FIntVector, TArray<UNavigationNode*>> _cells = { };
+	for (UNavigationNode* _node : NavigationNodes)
+		if (_node && _patched.Contains(GetGridCell(_node->NodeLocation())))
+		{
+			_patchNodes.Add(_node);
+			_cells.FindOrAdd(_getCell(_node->NodeLocation())).Add(_node);
 		}
+
+	for (UNavigationNode* _node : _patchNodes)
+	{
+		const FIntVector& _cell = _getCell(_node->NodeLocation());
+		for (int x = -1; x <= 1; ++x)
+			for (int y = -1; y <= 1; ++y)
+				for (int z = -1; z <= 1; ++z)
+				{
+					const TArray<UNavigationNode*>* _candidates = _cells.Find(_cell + FIntVector(x, y, z));
+					if (!_candidates) continue;
+
+					for (UNavigationNode* _candidate : *_candidates)
+					{
+						if (_candidate == _node) continue;
+						
+						if (_node->IsNodeAccessible() && _candidate->IsNodeAccessible() && FVector::Dist(_node->NodeLocation(), _candidate->NodeLocation()) <= _range)
+							_node->AddNeighbor(_candidate);
+						else
+							_node->RemoveNeighbor(_candidate);		//	Linker edges are added again by RestoreNodeLinks
+					}
+				}
 	}
 }
+#pragma endregion
 
-void ANavigationMesh::GenerateNavigationMeshComplex()
+#pragma region Tiles
+void ANavigationMesh::AddTileStreamingSource(AActor* _actor)
+{
+	if (_actor)
+		TileStreamingSources.AddUnique(_actor);
+}
+void ANavigationMesh::RemoveTileStreamingSource(AActor* _actor)
+{
+	TileStreamingSources.Remove(_actor);
+}
+
+void ANavigationMesh::UpdateTileStreaming()
+{
+	const FNavigationTileGrid& _grid = GetTileGrid();
+	TArray<FVector> _sources = { };
+	GetTileStreamingLocations(_sources);
+
+	//	Evict first : the Node slots of the evicted tiles are reused by the tiles loaded next
+	const float _unloadRange = FMath::Max(NavMeshSettings.TileUnloadRange, NavMeshSettings.TileLoadRange);
+	TArray<FIntPoint> _unloadTiles = { };
+	for (const TPair<FIntPoint, FNavigationNodeRange>& _tile : LoadedTiles)
+		if (GetTileSourceDistance(_tile.Key, _sources) > _unloadRange)
+			_unloadTiles.Add(_tile.Key);
+	for (const FIntPoint& _coord : _unloadTiles)
+		UnloadTile(_coord);
+
+	//	Tiles in load range of a source, closest first
+	TArray<TPair<float, FIntPoint>> _loadTiles = { };
+	const int _tileRange = FMath::CeilToInt(NavMeshSettings.TileLoadRange / (_grid.Gap * _grid.TileSize));
+	for (const FVector& _source : _sources)
+	{
+		const FIntPoint& _center = _grid.TileAt(_source);
+		for (int x = -_tileRange; x <= _tileRange; ++x)
+			for (int y = -_tileRange; y <= _tileRange; ++y)
+			{
+				const FIntPoint _coord = _center + FIntPoint(x, y);
+				if (!_grid.IsValidTile(_coord) || LoadedTiles.Contains(_coord) || PendingTiles.Contains(_coord) || MissingTiles.Contains(_coord)) continue;
+				
+				const float _distance = _grid.TileDistance(_coord, _source);
+				if (_distance <= NavMeshSettings.TileLoadRange)
+					_loadTiles.Add(TPair<float, FIntPoint>(_distance, _coord));
+			}
+	}
+	_loadTiles.Sort([](const TPair<float, FIntPoint>& _a, const TPair<float, FIntPoint>& _b) { return _a.Key < _b.Key; });
+	for (const TPair<float, FIntPoint>& _tile : _loadTiles)
+	{
+		if (PendingTiles.Num() >= NavMeshSettings.TileMaxPendingRequests) break;
+		if (!PendingTiles.Contains(_tile.Value))		//	Same tile around several sources
+			RequestTile(_tile.Value);
+	}
+}
+void ANavigationMesh::GetTileStreamingLocations(TArray<FVector>& _outLocations)
+{
+	TileStreamingSources.RemoveAll([](const TWeakObjectPtr<AActor>& _source) { return !_source.IsValid(); });
+	for (const TWeakObjectPtr<AActor>& _source : TileStreamingSources)
+		_outLocations.Add(_source->GetActorLocation());
+
+	for (FConstPlayerControllerIterator _iterator = GetWorld()->GetPlayerControllerIterator(); _iterator; ++_iterator)
+		if (const APlayerController* _controller = _iterator->Get())
+			if (const APawn* _pawn = _controller->GetPawn())
+				_outLocations.Add(_pawn->GetActorLocation());
+}
+float ANavigationMesh::GetTileSourceDistance(const FIntPoint& _coord, const TArray<FVector>& _sources) const
+{
+	const FNavigationTileGrid& _grid = GetTileGrid();
+	float _distance = UE_MAX_FLT;
+	for (const FVector& _source : _sources)
+		_distance = FMath::Min(_distance, _grid.TileDistance(_coord, _source));
+	return _distance;
+}
+
+void ANavigationMesh::RequestTile(const FIntPoint& _coord)
+{
+	PendingTiles.Add(_coord);
+
+	const TArray<FString> _paths =
+	{
+		FNavigationTileData::GetFilePath(FPaths::ProjectContentDir(), GetTileMeshName(), _coord),		//	Baked
+		FNavigationTileData::GetFilePath(FPaths::ProjectSavedDir(), GetTileMeshName(), _coord)			//	Generated at runtime
+	};
+	const FNavigationGridLayout& _layout = GetTileGrid().TileLayout(_coord, NavMeshSettings.TileSimpleGrid);
+	Async(EAsyncExecution::ThreadPool, [_mesh = TWeakObjectPtr<ANavigationMesh>(this), _coord, _paths, _layout]()
+	{
+		FNavigationTileDataPtr _tile = MakeShared<FNavigationTileData, ESPMode::ThreadSafe>();
+		bool _isLoaded = false;
+		for (const FString& _path : _paths)
+		{
+			_isLoaded = _tile->LoadFromFile(_path) && _tile->Coord == _coord && _tile->MatchLayout(_layout);
+			if (_isLoaded) break;
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [_mesh, _coord, _tile = _isLoaded ? _tile : nullptr]()
+		{
+			if (!_mesh.IsValid()) return;
+			if (_tile)
+				_mesh->OnTileReady(_coord, _tile);
+			else
+				_mesh->OnTileMissing(_coord);
+		});
+	});
+}
+void ANavigationMesh::OnTileReady(const FIntPoint& _coord, const FNavigationTileDataPtr& _tile)
+{
+	if (PendingTiles.Remove(_coord) == 0 || LoadedTiles.Contains(_coord)) return;		//	Cancelled
+
+	TArray<FVector> _sources = { };
+	GetTileStreamingLocations(_sources);
+	if (GetTileSourceDistance(_coord, _sources) > FMath::Max(NavMeshSettings.TileUnloadRange, NavMeshSettings.TileLoadRange)) return;	//	Not needed anymore
+
+	LoadTile(*_tile);
+}
+void ANavigationMesh::OnTileMissing(const FIntPoint& _coord)
+{
+	if (!PendingTiles.Contains(_coord)) return;
+
+	const bool _isGenerating = NavMeshSettings.GenerateMissingTiles && GenerateTile(_coord, [this, _coord](const FNavigationTileDataPtr& _tile)
+	{
+		const FString& _path = FNavigationTileData::GetFilePath(FPaths::ProjectSavedDir(), GetTileMeshName(), _coord);
+		Async(EAsyncExecution::ThreadPool, [_tile, _path]() { _tile->SaveToFile(_path); });		//	Loaded from the file next time
+		OnTileReady(_coord, _tile);
+	});
+	if (_isGenerating) return;
+
+	PendingTiles.Remove(_coord);
+	MissingTiles.Add(_coord);
+}
+
+bool ANavigationMesh::GenerateTile(const FIntPoint& _coord, TFunction<void(const FNavigationTileDataPtr&)> _onCompleted)
 {
-	if (NavMeshSettings.ObstacleLayers.IsEmpty())
-		UE_LOG(LogTemp, Warning, TEXT("WARNING : Navigation Mesh Settings -> Obstacle Layers is Empty ! Obstacle are ignored"));
 	if (NavMeshSettings.GroundLayers.IsEmpty())
 	{
 		UE_LOG(LogTemp, Error, TEXT("ERROR : Navigation Mesh Settings -> Ground Layers is Empty ! Node can NOT be created"));		
-		return;
+		return false;
 	}
-	
-	NavigationNodes.Empty();
-	const FVector& _location = GetActorLocation();
-	for (int x = 0; x < NavMeshSettings.NavigationGridSizeX; ++x)
+
+	const FNavigationMeshGeneratorPtr _generator = MakeShared<FNavigationMeshGenerator, ESPMode::ThreadSafe>(GetWorld(), NavMeshSettings, GetTileGrid().TileLayout(_coord, NavMeshSettings.TileSimpleGrid));
+	TileGenerators.Add(_coord, _generator);
+	_generator->Start([_mesh = TWeakObjectPtr<ANavigationMesh>(this), _generator = TWeakPtr<FNavigationMeshGenerator, ESPMode::ThreadSafe>(_generator), _coord, _onCompleted]()
 	{
-		for (int y = 0; y < NavMeshSettings.NavigationGridSizeY; ++y)
-		{
-			TArray<FHitResult> _results;
-			const FVector& _nodeLocation = _location + FVector(x * NavMeshSettings.NavigationGridGap, y * NavMeshSettings.NavigationGridGap, 0);
-			UKismetSystemLibrary::LineTraceMultiForObjects(GetWorld(), _nodeLocation, _nodeLocation - FVector(0, 0, NavMeshSettings.NavigationGridHeight), NavMeshSettings.GroundLayers, false, { }, EDrawDebugTrace::None, _results, true);
+		if (!_mesh.IsValid()) return;
 
-			const int _maxHit = _results.Num();
-			for (int i = 0; i < _maxHit; i++)
-			{
-				UNavigationNode* _node = NewObject<UNavigationNode>(this);
-				_node->InitializeNavigationNodeComplex(_results[i].ImpactPoint + _results[i].ImpactNormal * NavMeshSettings.NavigationGridSurfaceHeight, NavMeshSettings);
-				NavigationNodes.Add(_node);
-			}
-		}
+		FNavigationMeshGeneratorPtr _done = nullptr;
+		if (!_mesh->TileGenerators.RemoveAndCopyValue(_coord, _done) || _done != _generator.Pin()) return;
+
+		const FNavigationTileDataPtr _tile = MakeShared<FNavigationTileData, ESPMode::ThreadSafe>();
+		_tile->Coord = _coord;
+		_tile->MoveFromGenerator(*_done);
+		_onCompleted(_tile);
+	});
+	return true;
+}
+void ANavigationMesh::CancelTileRequests()
+{
+	for (const TPair<FIntPoint, FNavigationMeshGeneratorPtr>& _tileGenerator : TileGenerators)
+		_tileGenerator.Value->Cancel();
+	TileGenerators.Empty();
+	PendingTiles.Empty();			//	File reads still running are dropped when they complete
+}
+
+void ANavigationMesh::LoadTile(const FNavigationTileData& _tile)
+{
+	const int _count = _tile.SampleCount();
+	const int _first = AllocateNodeRange(_count);
+	for (int i = 0; i < _count; ++i)
+	{
+		UNavigationNode* _node = NewObject<UNavigationNode>(this);
+		_node->InitializeNavigationNode(_tile.Samples[i].Location, _tile.Samples[i].IsAccessible);
+		_node->SetNodeIndex(_first + i);
+		NavigationNodes[_first + i] = _node;
+	}
+	for (int i = 0; i < _count; ++i)
+	{
+		UNavigationNode* _node = NavigationNodes[_first + i];
+		const int _end = _tile.NeighborEnd(i);
+		for (int n = _tile.NeighborBegin(i); n < _end; ++n)
+			_node->AddNeighbor(NavigationNodes[_first + _tile.Neighbors[n]]);
+	}
+
+	LoadedTiles.Add(_tile.Coord, FNavigationNodeRange(_first, _count));
+	StitchTile(_tile.Coord);
+	TileGraphDirty = true;
+}
+void ANavigationMesh::UnloadTile(const FIntPoint& _coord)
+{
+	const FNavigationNodeRange _tile = LoadedTiles.FindAndRemoveChecked(_coord);
+	const int _end = _tile.FirstNode + _tile.NodeCount;
+	for (int i = _tile.FirstNode; i < _end; ++i)
+	{
+		UNavigationNode* _node = NavigationNodes[i];
+		if (!_node) continue;
+
+		for (UNavigationNode* _neighbor : _node->NodeNeighbors())
+			if (_neighbor && !_tile.ContainsNode(_neighbor->NodeIndex()))
+				_neighbor->RemoveNeighbor(_node);		//	Stitched edges go both ways
+		NavigationNodes[i] = nullptr;
 	}
-	
-	GenerateNodesNeighborsComplex();
 
-	OnNavMeshGeneration.Broadcast();
+	ReleaseNodeRange(_tile);
+	TileGraphDirty = true;
 }
-void ANavigationMesh::GenerateNodesNeighborsComplex()
+
+void ANavigationMesh::StitchTile(const FIntPoint& _coord)
 {
-	TArray<UNavigationNode*> _openList = NavigationNodes;
-	while (!_openList.IsEmpty())
+	const FNavigationNodeRange& _tile = LoadedTiles[_coord];
+	const FNavigationTileGrid& _grid = GetTileGrid();
+	const float _range = NavMeshSettings.NavigationGridGap + NavMeshSettings.AgentExtraWalkStep;
+
+	auto _getCell = [_range](const FVector& _location)
+	{
+		const FVector& _cell = _location / _range;
+		return FIntVector(FMath::FloorToInt(_cell.X), FMath::FloorToInt(_cell.Y), FMath::FloorToInt(_cell.Z));
+	};
+	//	Only Nodes within walk range of the tile sides can have a neighbor in another tile
+	auto _isBorderNode = [_range, &_grid](const FIntPoint& _tileCoord, const UNavigationNode* _node)
 	{
-		UNavigationNode* _node = _openList[0];
-		_openList.RemoveAt(0);
-		if (_node)
+		if (!_node || !_node->IsNodeAccessible()) return false;
+		
+		const FBox2D& _inner = _grid.TileBounds(_tileCoord).ExpandBy(-_range);
+		return !_inner.IsInside(FVector2D(_node->NodeLocation().X, _node->NodeLocation().Y));
+	};
+
+	//	Border Nodes of the tile in a spatial hash of cell size = range
+	TMap<FIntVector, TArray<UNavigationNode*>> _cells = { };
+	const int _end = _tile.FirstNode + _tile.NodeCount;
+	for (int i = _tile.FirstNode; i < _end; ++i)
+		if (_isBorderNode(_coord, NavigationNodes[i]))
+			_cells.FindOrAdd(_getCell(NavigationNodes[i]->NodeLocation())).Add(NavigationNodes[i]);
+	if (_cells.IsEmpty()) return;
+
+	for (int x = -1; x <= 1; ++x)
+		for (int y = -1; y <= 1; ++y)
 		{
-			TArray<UNavigationNode*> _nodes = GetCloseNodes(_node, NavMeshSettings.NavigationGridGap + NavMeshSettings.AgentExtraWalkStep);
-			const int _neighborMax = _nodes.Num();
-			for (int n = 0; n < _neighborMax; ++n)
+			const FIntPoint _otherCoord = _coord + FIntPoint(x, y);
+			const FNavigationNodeRange* _other = (x != 0 || y != 0) ? LoadedTiles.Find(_otherCoord) : nullptr;
+			if (!_other) continue;
+
+			const int _otherEnd = _other->FirstNode + _other->NodeCount;
+			for (int i = _other->FirstNode; i < _otherEnd; ++i)
 			{
-				UNavigationNode* _neighbor = _nodes[n]; 
-				_node->AddNeighbor(_neighbor);
-				_neighbor->AddNeighbor(_node);
+				UNavigationNode* _node = NavigationNodes[i];
+				if (!_isBorderNode(_otherCoord, _node)) continue;
+
+				const FIntVector& _cell = _getCell(_node->NodeLocation());
+				for (int cx = -1; cx <= 1; ++cx)
+					for (int cy = -1; cy <= 1; ++cy)
+						for (int cz = -1; cz <= 1; ++cz)
+						{
+							const TArray<UNavigationNode*>* _candidates = _cells.Find(_cell + FIntVector(cx, cy, cz));
+							if (!_candidates) continue;
+
+							for (UNavigationNode* _candidate : *_candidates)
+								if (FVector::Dist(_node->NodeLocation(), _candidate->NodeLocation()) <= _range)
+								{
+									_node->AddNeighbor(_candidate);
+									_candidate->AddNeighbor(_node);
+								}
+						}
 			}
 		}
+}
+
+int ANavigationMesh::AllocateNodeRange(const int _count)
+{
+	const int _max = FreeNodeRanges.Num();
+	for (int r = 0; r < _max; ++r)
+	{
+		FNavigationNodeRange& _range = FreeNodeRanges[r];
+		if (_range.NodeCount < _count) continue;
+
+		const int _first = _range.FirstNode;
+		_range.FirstNode += _count;
+		_range.NodeCount -= _count;
+		if (_range.NodeCount == 0)
+			FreeNodeRanges.RemoveAt(r);
+		return _first;
+	}
+	return NavigationNodes.AddZeroed(_count);
+}
+void ANavigationMesh::ReleaseNodeRange(const FNavigationNodeRange& _range)
+{
+	FreeNodeRanges.Add(_range);
+	FreeNodeRanges.Sort([](const FNavigationNodeRange& _a, const FNavigationNodeRange& _b) { return _a.FirstNode < _b.FirstNode; });
+	for (int r = FreeNodeRanges.Num() - 1; r > 0; --r)		//	Merge the contiguous ranges
+	{
+		FNavigationNodeRange& _previous = FreeNodeRanges[r - 1];
+		if (_previous.FirstNode + _previous.NodeCount != FreeNodeRanges[r].FirstNode) continue;
+
+		_previous.NodeCount += FreeNodeRanges[r].NodeCount;
+		FreeNodeRanges.RemoveAt(r);
+	}
+
+	//	Slots at the end are given back : NavigationNodes stays in the size of the loaded area
+	const FNavigationNodeRange& _last = FreeNodeRanges.Last();
+	if (_last.FirstNode + _last.NodeCount == NavigationNodes.Num())
+	{
+		NavigationNodes.SetNum(_last.FirstNode);
+		FreeNodeRanges.Pop();
 	}
 }
 
-TArray<UNavigationNode*> ANavigationMesh::GetCloseNodes(const UNavigationNode* _from, const float _range)
+FString ANavigationMesh::GetTileMeshName() const
 {
-	if (!_from) return { };
-	
-	TArray<UNavigationNode*> _nodes = { };
+	const FString& _level = UWorld::RemovePIEPrefix(FPackageName::GetShortName(GetPackage()->GetName()));
+	return _level + TEXT("_") + GetName();
+}
+#pragma endregion
 
-	const int _max = NavigationNodes.Num();
-	for (int i = 0; i < _max; ++i)
+#if WITH_EDITOR
+void ANavigationMesh::PostRegisterAllComponents()
+{
+	Super::PostRegisterAllComponents();
+
+	BindLevelActorEvents();
+}
+
+#pragma region Dirty Regions Editor
+void ANavigationMesh::BindLevelActorEvents()
+{
+	const UWorld* _world = GetWorld();
+	if (!GEngine || !_world || _world->IsGameWorld() || HasAnyFlags(RF_ClassDefaultObject) || ActorMovedHandle.IsValid()) return;
+
+	ActorMovedHandle = GEngine->OnActorMoved().AddUObject(this, &ANavigationMesh::OnLevelActorMoved);
+	ActorAddedHandle = GEngine->OnLevelActorAdded().AddUObject(this, &ANavigationMesh::OnLevelActorMoved);
+	ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddUObject(this, &ANavigationMesh::OnLevelActorDeleted);
+}
+void ANavigationMesh::UnbindLevelActorEvents()
+{
+	if (!GEngine || !ActorMovedHandle.IsValid()) return;
+
+	GEngine->OnActorMoved().Remove(ActorMovedHandle);
+	GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+	GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+	ActorMovedHandle.Reset();
+	ActorAddedHandle.Reset();
+	ActorDeletedHandle.Reset();
+}
+
+void ANavigationMesh::OnLevelActorMoved(AActor* _actor)
+{
+	if (!_actor || _actor->GetWorld() != GetWorld() || NavigationNodes.IsEmpty()) return;
+	if (!HasLayerActorBounds)
+		CacheLayerActorBounds();
+
+	FBox _previousBounds = FBox(ForceInit);
+	LayerActorBounds.RemoveAndCopyValue(_actor, _previousBounds);
+	MarkDirtyBounds(_previousBounds);			//	Area the actor left
+	if (!IsNavigationLayerActor(_actor)) return;
+
+	const FBox& _bounds = _actor->GetComponentsBoundingBox();
+	LayerActorBounds.Add(_actor, _bounds);
+	MarkDirtyBounds(_bounds);
+}
+void ANavigationMesh::OnLevelActorDeleted(AActor* _actor)
+{
+	if (!_actor || _actor->GetWorld() != GetWorld() || NavigationNodes.IsEmpty()) return;
+
+	FBox _bounds = FBox(ForceInit);
+	LayerActorBounds.RemoveAndCopyValue(_actor, _bounds);
+	if (!_bounds.IsValid && IsNavigationLayerActor(_actor))
+		_bounds = _actor->GetComponentsBoundingBox();
+	MarkDirtyBounds(_bounds);
+}
+
+bool ANavigationMesh::IsNavigationLayerActor(const AActor* _actor) const
+{
+	if (!_actor || _actor == this) return false;
+
+	const float _gap = GridLayout.Gap > 0 ? GridLayout.Gap : NavMeshSettings.NavigationGridGap;
+	const FVector& _origin = GridLayout.Gap > 0 ? GridLayout.Origin : GetActorLocation();
+	const FVector _extent = FVector((NavMeshSettings.NavigationGridSizeX - 1) * _gap, (NavMeshSettings.NavigationGridSizeY - 1) * _gap, 0);
+	const FBox _area = FBox(_origin - FVector(0, 0, NavMeshSettings.NavigationGridHeight), _origin + _extent).ExpandBy(NavMeshSettings.ObstacleAvoidanceSize + NavMeshSettings.AgentHeight);
+	if (!_area.Intersect(_actor->GetComponentsBoundingBox())) return false;
+
+	bool _isOnLayers = false;
+	_actor->ForEachComponent<UPrimitiveComponent>(false, [&](const UPrimitiveComponent* _component)
+	{
+		if (_isOnLayers || !_component->IsCollisionEnabled()) return;
+
+		const ECollisionChannel _channel = _component->GetCollisionObjectType();
+		for (const TEnumAsByte<EObjectTypeQuery>& _layer : NavMeshSettings.GroundLayers)
+			_isOnLayers |= UEngineTypes::ConvertToCollisionChannel(_layer) == _channel;
+		for (const TEnumAsByte<EObjectTypeQuery>& _layer : NavMeshSettings.ObstacleLayers)
+			_isOnLayers |= UEngineTypes::ConvertToCollisionChannel(_layer) == _channel;
+	});
+	return _isOnLayers;
+}
+void ANavigationMesh::CacheLayerActorBounds()
+{
+	LayerActorBounds.Reset();
+	HasLayerActorBounds = true;
+	for (TActorIterator<AActor> _iterator = TActorIterator<AActor>(GetWorld()); _iterator; ++_iterator)
+		if (IsNavigationLayerActor(*_iterator))
+			LayerActorBounds.Add(*_iterator, _iterator->GetComponentsBoundingBox());
+}
+#pragma endregion
+
+#pragma region Navigation Mesh Init Editor
+void ANavigationMesh::GenerateNavigationMeshSimple()
+{
+	StartNavigationMeshGeneration(true);
+}
+void ANavigationMesh::GenerateNavigationMeshComplex()
+{
+	StartNavigationMeshGeneration(false);
+}
+void ANavigationMesh::StartNavigationMeshGeneration(const bool _isSimpleGrid)
+{
+	const FNavigationGridLayout _layout = FNavigationGridLayout(GetActorLocation(), NavMeshSettings.NavigationGridGap, NavMeshSettings.NavigationGridSizeX, NavMeshSettings.NavigationGridSizeY, _isSimpleGrid);
+	StartNavigationMeshGeneration(NavMeshSettings, _layout, 0, FOnNavigationMeshBuilt());
+}
+
+void ANavigationMesh::BakeNavigationTiles()
+{
+	if (!NavMeshSettings.UseTiles)
 	{
-		if (UNavigationNode* _to = NavigationNodes[i])
-			if (_to != _from)
-				if (FVector::Dist(_from->NodeLocation(), _to->NodeLocation()) <= _range)
-					_nodes.Add(_to);
+		UE_LOG(LogTemp, Warning, TEXT("WARNING : Navigation Mesh Settings -> Use Tiles is disabled, nothing to bake"));
+		return;
 	}
 
-	return _nodes;
+	const FNavigationTileGrid& _grid = GetTileGrid();
+	TileBakeQueue.Reset();
+	for (int x = _grid.TileCountX() - 1; x >= 0; --x)		//	Popped from the end : baked in order
+		for (int y = _grid.TileCountY() - 1; y >= 0; --y)
+			TileBakeQueue.Add(FIntPoint(x, y));
+	UE_LOG(LogTemp, Log, TEXT("Baking %d Navigation Mesh tiles..."), TileBakeQueue.Num());
+	BakeNextTile();
+}
+void ANavigationMesh::BakeNextTile()
+{
+	if (TileBakeQueue.IsEmpty()) return;
+
+	const FIntPoint _coord = TileBakeQueue.Pop();
+	const bool _isStarted = GenerateTile(_coord, [this](const FNavigationTileDataPtr& _tile)
+	{
+		const FString& _path = FNavigationTileData::GetFilePath(FPaths::ProjectContentDir(), GetTileMeshName(), _tile->Coord);
+		if (!_tile->SaveToFile(_path))
+			UE_LOG(LogTemp, Error, TEXT("ERROR : Navigation Mesh tile can NOT be saved to %s"), *_path);
+		if (TileBakeQueue.IsEmpty())
+			UE_LOG(LogTemp, Log, TEXT("Navigation Mesh tiles baked"));
+		BakeNextTile();
+	});
+	if (!_isStarted)
+		TileBakeQueue.Reset();
 }
 
-bool ANavigationMesh::CheckAgentCanWalkBetweenNodes(const UNavigationNode* _from, const UNavigationNode* _to, const float& _range) const
+void ANavigationMesh::BakeNavigationGraph()
 {
-	if (!_from || !_to) return false;
-	
-	return FVector::Dist(_from->NodeLocation(), _to->NodeLocation()) <= _range;
+	if (NavMeshSettings.UseTiles || Generator || NavigationNodes.IsEmpty())
+	{
+		UE_LOG(LogTemp, Error, TEXT("ERROR : Navigation Mesh has no generated Nodes to bake (tiles are baked with Bake Navigation Tiles)"));
+		return;
+	}
+
+	const TSharedRef<FNavigationGraph, ESPMode::ThreadSafe> _graph = FNavigationGraph::Compile(NavigationNodes, GetCompileLayout(), GetCompileLandmarkCount());
+	const FString& _path = GetBakedGraphPath();
+	uint32 _checksum = 0;
+	if (!_graph->SaveBakedFile(_path, _checksum))
+	{
+		UE_LOG(LogTemp, Error, TEXT("ERROR : Navigation Mesh graph can NOT be baked to %s"), *_path);
+		return;
+	}
+
+	//	Nodes of the Node Linkers are still used at runtime (Passed By events), their edges are in the baked graph
+	TMap<int, UNavigationNode*> _keptNodes = { };
+	for (TActorIterator<ANavigationNodeLinker> _it(GetWorld()); _it; ++_it)
+		for (UNavigationNode* _node : { _it->GetNodeLeft(), _it->GetNodeRight() })
+			if (_it->GetNavigationMesh() == this && _node && GetNavigationNode(_node->NodeIndex()) == _node)
+			{
+				_node->ClearNeighbors();		//	Would keep the other Nodes alive
+				_keptNodes.Add(_node->NodeIndex(), _node);
+			}
+
+	const int _nodeCount = NavigationNodes.Num();
+	NavigationNodes.Empty();
+	HasBakedGraph = true;
+	BakedGraphChecksum = _checksum;
+	BakedNodes = MoveTemp(_keptNodes);
+	CompileNavigationGraph();
+	MarkPackageDirty();
+	UE_LOG(LogTemp, Log, TEXT("Navigation Mesh baked : %d Nodes in %s, %d Node objects kept"), _nodeCount, *_path, BakedNodes.Num());
+}
+void ANavigationMesh::UnbakeNavigationGraph()
+{
+	if (!IsNavigationGraphBaked()) return;
+
+	const FNavigationGraphPtr _graph = GetNavigationGraph();
+	const int _max = _graph->NodeCount();
+	NavigationNodes.SetNumZeroed(_max);
+	for (int i = 0; i < _max; ++i)
+	{
+		UNavigationNode* _node = BakedNodes.FindRef(i);
+		if (!_node)
+			_node = NewObject<UNavigationNode>(this);
+		_node->InitializeNavigationNode(_graph->NodeLocation(i), _graph->IsNodeAccessible(i));
+		_node->SetNodeWaypoint(_graph->IsNodeWaypoint(i));
+		_node->SetNodeIndex(i);
+		NavigationNodes[i] = _node;
+	}
+	for (int i = 0; i < _max; ++i)
+		for (int e = _graph->NeighborBegin(i); e < _graph->NeighborEnd(i); ++e)
+			NavigationNodes[i]->AddNeighbor(NavigationNodes[_graph->Neighbors[e]]);
+
+	ClearBakedNavigationGraph();
+	CompileNavigationGraph();
+	CacheLayerActorBounds();
+	MarkPackageDirty();
 }
 #pragma endregion
 
@@ -250,9 +1304,26 @@ void ANavigationMesh::DrawNavigationMeshDebug() const
 	DrawDebugSolidBox(GetWorld(), GetActorLocation() + _gap, _gap, _color);
 	_color.A = 5;
 	DrawDebugSolidBox(GetWorld(), _center, _area, _color);
+
+	if (Generator)
+		DrawDebugString(GetWorld(), GetActorLocation(), FString::Printf(TEXT("Generating Navigation Mesh... %d%%"), FMath::RoundToInt(Generator->Progress() * 100)), nullptr, NavigationMeshDebugColor, 0);
 }
 void ANavigationMesh::DrawNavigationNodes()
 {
+	if (IsNavigationGraphBaked())		//	No Node objects : draw the graph
+	{
+		const FNavigationGraphPtr& _graph = GetNavigationGraph();
+		const int _max = _graph->NodeCount();
+		for (int i = 0; i < _max; ++i)
+		{
+			const FVector& _location = _graph->NodeLocation(i);
+			DrawDebugSphere(GetWorld(), _location, 3, 3, _graph->IsNodeAccessible(i) ? NodeDebugColor : FColor::Black, false, DebugTime);
+			for (int e = _graph->NeighborBegin(i); e < _graph->NeighborEnd(i); ++e)
+				DrawDebugLine(GetWorld(), _location, _graph->NodeLocation(_graph->Neighbors[e]), NodeLineDebugColor, false, DebugTime);
+		}
+		return;
+	}
+
 	const int& _max = NavigationNodes.Num();
 	for (int i = 0; i < _max; ++i)
 	{
@@ -272,15 +1343,15 @@ void ANavigationMesh::TestGetPath()
 		Algo->OnComputePathFailed.AddUniqueDynamic(this, &ANavigationMesh::TestPathFail);		
 	}
 	
-	if (!StartTest || !EndTest || !Algo) return;
+	if (!StartTest || !EndTest || !Algo || !GetNavigationGraph()) return;
 	
 	const FVector& _startLocation = StartTest->GetActorLocation();
 	const FVector& _endLocation = EndTest->GetActorLocation();
 
-	UNavigationNode* _startNode = GetClosestNode(_startLocation);
-	UNavigationNode* _endNode = GetClosestNode(_endLocation);
+	const int _startNode = GetClosestNodeIndex(_startLocation);
+	const int _endNode = GetClosestNodeIndex(_endLocation);
 
-	Algo->ComputePath(_startNode, _endNode);
+	Algo->ComputePath(MakePathRequest(_startNode, _endNode));
 }
 
 void ANavigationMesh::TestGetClose()
@@ -297,15 +1368,36 @@ void ANavigationMesh::TestGetClose()
 	}
 }
 
+void ANavigationMesh::TestRaycast()
+{
+	if (!StartTest || !EndTest) return;
+
+	const FVector& _startLocation = StartTest->GetActorLocation();
+	const FVector& _endLocation = EndTest->GetActorLocation();
+	FNavigationRaycastHit _hit;
+	NavigationRaycast(_startLocation, _endLocation, _hit);
+
+	DrawDebugLine(GetWorld(), _startLocation, _hit.Location, FColor::Green, false, DebugTime, 0, 2);
+	if (!_hit.IsHit) return;
+
+	DrawDebugLine(GetWorld(), _hit.Location, _endLocation, FColor::Red, false, DebugTime, 0, 2);
+	if (const FNavigationGraphPtr& _graph = GetNavigationGraph())
+	{
+		if (_graph->IsValidNode(_hit.LastNode))
+			DrawDebugSphere(GetWorld(), _graph->NodeLocation(_hit.LastNode), 10, 10, FColor::Green, false, DebugTime);
+		if (_graph->IsValidNode(_hit.HitNode))
+			DrawDebugSphere(GetWorld(), _graph->NodeLocation(_hit.HitNode), 10, 10, FColor::Red, false, DebugTime);
+	}
+	UE_LOG(LogTemp, Log, TEXT("Navigation raycast hit at %.2f of the segment (last Node %d, hit Node %d)"), _hit.Fraction, _hit.LastNode, _hit.HitNode);
+}
+
 void ANavigationMesh::TestPath(FNavigationNodePath _path)
 {
 	if (_path.NodePath.IsEmpty()) return;
 
-	TArray<UNavigationNode*>& _nodes = _path.NodePath;
-	const UNavigationNode* _startNode = _nodes[0];
-	const UNavigationNode* _endNode = _nodes.Last();
-	const FVector& _startNodeLocation = _startNode->NodeLocation();
-	const FVector& _endNodeLocation = _endNode->NodeLocation();
+	const TArray<FVector>& _nodes = _path.NodeLocations;
+	const FVector& _startNodeLocation = _nodes[0];
+	const FVector& _endNodeLocation = _nodes.Last();
 	
 	DrawDebugSphere(GetWorld(), _startNodeLocation, 15, 10, FColor::Green, false, DebugTime);
 	DrawDebugSphere(GetWorld(), _endNodeLocation, 15, 10, FColor::Red, false, DebugTime);
@@ -314,19 +1406,78 @@ void ANavigationMesh::TestPath(FNavigationNodePath _path)
 	const int& _max = _nodes.Num();
 	for (int i = 0; i < _max; ++i)
 	{
-		if (const UNavigationNode* _node = _nodes[i])
-		{
-			const FVector& _location = _node->NodeLocation();
-			DrawDebugSphere(GetWorld(), _location, 5, 10, FColor::Blue, false, DebugTime);
+		const FVector& _location = _nodes[i];
+		DrawDebugSphere(GetWorld(), _location, 5, 10, FColor::Blue, false, DebugTime);
 
-			if (i + 1 < _max)
-				DrawDebugDirectionalArrow(GetWorld(), _location, _nodes[i + 1]->NodeLocation(), 5, FColor::Blue, false, DebugTime);
-		}
+		if (i + 1 < _max)
+			DrawDebugDirectionalArrow(GetWorld(), _location, _nodes[i + 1], 5, FColor::Blue, false, DebugTime);
 	}
 }
 void ANavigationMesh::TestPathFail()
 {
 	UE_LOG(LogTemp, Warning, TEXT("Found path failed"))
 }
+
+void ANavigationMesh::TestSearchModes()
+{
+	const FNavigationGraphPtr _graph = GetNavigationGraph();
+	if (!_graph) return;
+
+	TArray<int> _accessibleNodes = { };
+	for (int i = 0; i < _graph->NodeCount(); ++i)
+		if (_graph->IsNodeAccessible(i))
+			_accessibleNodes.Add(i);
+	if (_accessibleNodes.Num() < 2) return;
+
+	FRandomStream _random = FRandomStream(TestQueryCount);		//	Same queries on each run
+	TArray<FIntPoint> _queries = { };
+	for (int q = 0; q < TestQueryCount; ++q)
+		_queries.Add(FIntPoint(_accessibleNodes[_random.RandHelper(_accessibleNodes.Num())], _accessibleNodes[_random.RandHelper(_accessibleNodes.Num())]));
+
+	const FNavigationBlockedNodesPtr& _blocked = GetBlockedNodes();
+	FNavigationSearch _search;
+	TArray<int> _path = { };
+	for (const ENavigationSearchMode _mode : { ENavigationSearchMode::SearchAStar, ENavigationSearchMode::SearchBidirectional })
+	{
+		int64 _expansions = 0;
+		int _found = 0;
+		int _invalid = 0;
+		double _cost = 0;
+		double _seconds = 0;
+		for (const FIntPoint& _query : _queries)
+		{
+			const double _time = FPlatformTime::Seconds();
+			const bool _isFound = _mode == ENavigationSearchMode::SearchBidirectional ?
+				_search.FindPathBidirectional(*_graph, _query.X, _query.Y, _path, nullptr, _blocked.Get()) : _search.FindPath(*_graph, _query.X, _query.Y, _path, nullptr, _blocked.Get());
+			_seconds += FPlatformTime::Seconds() - _time;
+			_expansions += _search.SearchExpansions();
+			if (!_isFound) continue;
+
+			//	A path stepping between two unlinked Nodes is a failed test case, not a crash
+			double _pathCost = 0;
+			bool _isValid = true;
+			for (int i = 1; i < _path.Num() && _isValid; ++i)
+			{
+				if (_graph->FindEdge(_path[i - 1], _path[i]) == INDEX_NONE)
+				{
+					UE_LOG(LogTemp, Error, TEXT("ERROR : %s path from %d to %d steps from %d to %d without an Edge"),
+						*UEnum::GetDisplayValueAsText(_mode).ToString(), _query.X, _query.Y, _path[i - 1], _path[i]);
+					_isValid = false;
+					continue;
+				}
+				_pathCost += _graph->EdgeCost(_path[i - 1], _path[i]);
+			}
+			if (!_isValid)
+			{
+				_invalid++;
+				continue;
+			}
+			_found++;
+			_cost += _pathCost;
+		}
+		UE_LOG(LogTemp, Log, TEXT("%s : %d / %d paths, %d invalid, %lld Nodes expanded, total cost %.1f, %.2f ms"),
+			*UEnum::GetDisplayValueAsText(_mode).ToString(), _found, _queries.Num(), _invalid, _expansions, _cost, _seconds * 1000.0);
+	}
+}
 #pragma endregion
 #endif
\ No newline at end of file
@@ -0,0 +1,303 @@
+#include "NavigationMeshGenerator.h"
+
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+#include "Physics/PhysicsInterfaceCore.h"
+
+#include "NavigationNode.h"
+
+namespace NavigationMeshGenerator
+{
+	/**
+	 * Run scene queries from a worker thread under the read lock of the physics scene.
+	 * The game thread takes the write lock of the scene to add, remove or move bodies, so the queries never see a scene being modified,
+	 * and workers holding the read lock at the same time don't wait for each other.
+	 */
+	template<typename TQueries>
+	FORCEINLINE void ReadScene(const UWorld* _world, TQueries&& _queries)
+	{
+		if (FPhysScene* _scene = _world->GetPhysicsScene())
+			FPhysicsCommand::ExecuteRead(_scene, [&]() { _queries(); });
+	}
+}
+
+FNavigationMeshGenerator::FNavigationMeshGenerator(UWorld* _world, const FNavigationMeshSettings& _settings, const FNavigationGridLayout& _layout, const int64 _memoryBudget) :
+World(_world),
+Settings(_settings),
+Layout(_layout),
+MemoryBudget(_memoryBudget)
+{ }
+
+int64 FNavigationMeshGenerator::EstimateNodeMemory()
+{
+	constexpr int64 _neighbors = 8;					//	Grid Nodes have up to 8 neighbors
+	const int64 _node = sizeof(UNavigationNode) + _neighbors * sizeof(UNavigationNode*) * 3;		//	Neighbors + neighbor lookup set
+	const int64 _graph = 3 * sizeof(float) + sizeof(uint8) + 2 * sizeof(int) + _neighbors * 2 * (sizeof(int) + sizeof(float));		//	Positions, flags, offsets, edges both ways
+	return _node + _graph;
+}
+
+void FNavigationMeshGenerator::Start(TFunction<void()> _onCompleted)
+{
+	StartTime = FPlatformTime::Seconds();
+	Task = Async(EAsyncExecution::ThreadPool, [_generator = AsShared(), _onCompleted]()
+	{
+		_generator->Run();
+		if (_generator->IsCancelled()) return;
+
+		AsyncTask(ENamedThreads::GameThread, [_generator, _onCompleted]()
+		{
+			if (!_generator->IsCancelled())
+				_onCompleted();
+		});
+	});
+}
+
+void FNavigationMeshGenerator::Cancel()
+{
+	Cancelled = true;
+}
+
+void FNavigationMeshGenerator::Wait()
+{
+	if (Task.IsValid())
+		Task.Wait();
+}
+
+void FNavigationMeshGenerator::MoveResults(TArray<FNavigationGenerationSample>& _outSamples, TArray<int>& _outNeighborOffsets, TArray<int>& _outNeighbors)
+{
+	_outSamples = MoveTemp(Samples);
+	_outNeighborOffsets = MoveTemp(NeighborOffsets);
+	_outNeighbors = MoveTemp(Neighbors);
+}
+
+void FNavigationMeshGenerator::Run()
+{
+	if (Layout.IsSimpleGrid)
+		TraceSimpleGrid();
+	else
+		TraceComplexGrid();
+	if (IsCancelled() || IsOverBudget) return;
+
+	if (Layout.IsSimpleGrid)
+		GenerateNeighborsSimple();
+	else
+		GenerateNeighborsComplex();
+}
+
+bool FNavigationMeshGenerator::CheckMemoryBudget(const int64 _nodeCount)
+{
+	IsOverBudget = MemoryBudget > 0 && _nodeCount * EstimateNodeMemory() > MemoryBudget;
+	return !IsOverBudget;
+}
+
+void FNavigationMeshGenerator::TraceSimpleGrid()
+{
+	if (!CheckMemoryBudget(static_cast<int64>(Layout.SizeX) * Layout.SizeY)) return;		//	Before the grid size can overflow (grid size is not clamped)
+
+	const int _max = Layout.SizeX * Layout.SizeY;
+	TotalWork = FMath::Max(1, _max);
+
+	Samples.SetNum(_max);
+	for (int x = 0; x < Layout.SizeX; ++x)				//	Grid positions in bulk, Node index = X * SizeY + Y
+		for (int y = 0; y < Layout.SizeY; ++y)
+			Samples[x * Layout.SizeY + y].Location = CellLocation(x, y);
+
+	const UWorld* _world = World.Get();
+	if (!_world) return;
+
+	const FCollisionObjectQueryParams _groundLayers = FCollisionObjectQueryParams(Settings.GroundLayers);
+	const FCollisionQueryParams _params = FCollisionQueryParams(SCENE_QUERY_STAT(NavigationMeshGeneration), false);
+	ParallelFor(_max, [&](const int i)
+	{
+		if (IsCancelled()) return;
+
+		FNavigationGenerationSample& _sample = Samples[i];
+		const FVector _endLocation = _sample.Location - FVector(0, 0, Settings.NavigationGridHeight);
+
+		NavigationMeshGenerator::ReadScene(_world, [&]()
+		{
+			FHitResult _result;
+			// Line Trace to check if Node is above the Ground
+			if (_world->LineTraceSingleByObjectType(_result, _sample.Location, _endLocation, _groundLayers, _params))
+			{
+				_sample.Location = _result.ImpactPoint + _result.ImpactNormal * Settings.NavigationGridSurfaceHeight;
+				_sample.IsAccessible = CheckLocationAccessibility(_world, _sample.Location);
+			}
+		});
+		DoneWork.fetch_add(1, std::memory_order_relaxed);
+	});
+}
+
+void FNavigationMeshGenerator::TraceComplexGrid()
+{
+	const int _columnMax = Layout.SizeX * Layout.SizeY;
+	TotalWork = FMath::Max(1, _columnMax * 2);			//	Ground hits of the columns, then accessibility of every hit (estimated one per column)
+
+	const UWorld* _world = World.Get();
+	if (!_world) return;
+
+	const FCollisionObjectQueryParams _groundLayers = FCollisionObjectQueryParams(Settings.GroundLayers);
+	const FCollisionQueryParams _params = FCollisionQueryParams(SCENE_QUERY_STAT(NavigationMeshGeneration), false);
+
+	//	Every ground layer hit under each grid cell
+	TArray<TArray<FVector>> _columns = { };
+	_columns.SetNum(_columnMax);
+	ParallelFor(_columnMax, [&](const int i)
+	{
+		if (IsCancelled()) return;
+
+		const FVector _location = CellLocation(i / Layout.SizeY, i % Layout.SizeY);
+		TArray<FHitResult> _results;
+		NavigationMeshGenerator::ReadScene(_world, [&]() { _world->LineTraceMultiByObjectType(_results, _location, _location - FVector(0, 0, Settings.NavigationGridHeight), _groundLayers, _params); });
+		for (const FHitResult& _result : _results)
+			_columns[i].Add(_result.ImpactPoint + _result.ImpactNormal * Settings.NavigationGridSurfaceHeight);
+		DoneWork.fetch_add(1, std::memory_order_relaxed);
+	});
+	if (IsCancelled()) return;
+
+	int _max = 0;
+	for (const TArray<FVector>& _column : _columns)
+		_max += _column.Num();
+	if (!CheckMemoryBudget(_max)) return;
+
+	Samples.Reserve(_max);
+	for (const TArray<FVector>& _column : _columns)		//	Same Node order as a column by column generation
+		for (const FVector& _location : _column)
+			Samples.Add(FNavigationGenerationSample(_location, false));
+	TotalWork = FMath::Max(1, _columnMax + _max);
+
+	ParallelFor(_max, [&](const int i)
+	{
+		if (IsCancelled()) return;
+
+		FNavigationGenerationSample& _sample = Samples[i];
+		NavigationMeshGenerator::ReadScene(_world, [&]()
+		{
+			FHitResult _result;
+			// Check if there is no Walkable ground above node (with Agent Height)
+			_sample.IsAccessible = !_world->LineTraceSingleByObjectType(_result, _sample.Location, _sample.Location + FVector(0, 0, Settings.AgentHeight), _groundLayers, _params)
+				&& CheckLocationAccessibility(_world, _sample.Location);
+		});
+		DoneWork.fetch_add(1, std::memory_order_relaxed);
+	});
+}
+
+#pragma region Neighbors
+void FNavigationMeshGenerator::GenerateNeighborsSimple()
+{
+	const int _max = Samples.Num();
+	const int _maxX = Layout.SizeX;
+	const int _maxY = Layout.SizeY;
+	const float _range = Settings.NavigationGridGap + Settings.AgentExtraWalkStep;
+	TArray<TArray<int>> _neighbors = { };
+	_neighbors.SetNum(_max);
+	ParallelFor(_max, [&](const int i)
+	{
+		if (IsCancelled() || !Samples[i].IsAccessible) return;
+																	//	Those Conditions works with the NavMesh generation : Line X -> Generate All Y Node -> Go Next Line X...
+		const bool _canRight = i % _maxY != _maxY - 1;				//	If i % MaxY == MaxY - 1 -> Means i is on the last element of the Y Line (on the Right Side, then can't go more to the Right)
+		const bool _canLeft = i % _maxY != 0;						//	If i % MaxY == 0		-> Means i is in the first element of the Y Line (on the Left side, then can't go more to the Left) 
+		const bool _canDown = i >= _maxY;							//	While i is NOT on the first Y Line	-> Can Go Down
+		const bool _canTop = i < _maxX * _maxY - _maxY;				//	While i < Maximum Node - 1 Y Range	-> Can Top 
+
+		TArray<int>& _nodeNeighbors = _neighbors[i];
+		auto _tryAdd = [&](const bool _can, const int _index)
+		{
+			if (_can && CheckAgentCanWalkBetweenSamples(i, _index, _range))
+				_nodeNeighbors.Add(_index);
+		};
+		_tryAdd(_canRight, i + 1);
+		_tryAdd(_canLeft, i - 1);
+		_tryAdd(_canTop, i + _maxY);
+		_tryAdd(_canTop && _canRight, i + 1 + _maxY);
+		_tryAdd(_canTop && _canLeft, i - 1 + _maxY);
+		_tryAdd(_canDown, i - _maxY);
+		_tryAdd(_canDown && _canRight, i + 1 - _maxY);
+		_tryAdd(_canDown && _canLeft, i - 1 - _maxY);
+	});
+	SetNeighbors(_neighbors);
+}
+
+void FNavigationMeshGenerator::GenerateNeighborsComplex()
+{
+	const float _range = Settings.NavigationGridGap + Settings.AgentExtraWalkStep;
+	const int _max = Samples.Num();
+
+	//	Bucket Nodes in a spatial hash of cell size = range : Neighbors of a Node can only be in the 27 cells around its own
+	TMap<FIntVector, TArray<int>> _cells = { };
+	_cells.Reserve(_max);
+	TArray<FIntVector> _sampleCells = { };
+	_sampleCells.SetNumUninitialized(_max);
+	for (int i = 0; i < _max; ++i)
+	{
+		if (!Samples[i].IsAccessible)
+		{
+			_sampleCells[i] = FIntVector(MAX_int32);
+			continue;
+		}
+		
+		const FVector& _location = Samples[i].Location / _range;
+		_sampleCells[i] = FIntVector(FMath::FloorToInt(_location.X), FMath::FloorToInt(_location.Y), FMath::FloorToInt(_location.Z));
+		_cells.FindOrAdd(_sampleCells[i]).Add(i);
+	}
+
+	TArray<TArray<int>> _neighbors = { };
+	_neighbors.SetNum(_max);
+	ParallelFor(_max, [&](const int i)
+	{
+		if (IsCancelled() || _sampleCells[i].X == MAX_int32) return;
+
+		for (int x = -1; x <= 1; ++x)
+			for (int y = -1; y <= 1; ++y)
+				for (int z = -1; z <= 1; ++z)
+				{
+					const TArray<int>* _cell = _cells.Find(_sampleCells[i] + FIntVector(x, y, z));
+					if (!_cell) continue;
+
+					for (const int _index : *_cell)
+						if (_index != i && CheckAgentCanWalkBetweenSamples(i, _index, _range))
+							_neighbors[i].Add(_index);
+				}
+		_neighbors[i].Sort();				//	Same order whatever the cell order
+	});
+	SetNeighbors(_neighbors);
+}
+
+bool FNavigationMeshGenerator::CheckAgentCanWalkBetweenSamples(const int _from, const int _to, const float _range) const
+{
+	const FNavigationGenerationSample& _fromSample = Samples[_from];
+	const FNavigationGenerationSample& _toSample = Samples[_to];
+	if (!_fromSample.IsAccessible || !_toSample.IsAccessible) return false;
+	
+	return FVector::Dist(_fromSample.Location, _toSample.Location) <= _range;
+}
+
+void FNavigationMeshGenerator::SetNeighbors(const TArray<TArray<int>>& _neighbors)
+{
+	const int _max = _neighbors.Num();
+	NeighborOffsets.SetNumUninitialized(_max + 1);
+	Neighbors.Reset();
+	for (int i = 0; i < _max; ++i)
+	{
+		NeighborOffsets[i] = Neighbors.Num();
+		Neighbors.Append(_neighbors[i]);
+	}
+	NeighborOffsets[_max] = Neighbors.Num();
+}
+#pragma endregion
+
+bool FNavigationMeshGenerator::CheckLocationAccessibility(const UWorld* _world, const FVector& _location) const
+{
+	if (Settings.ObstacleLayers.IsEmpty())
+		return true;
+
+	const FCollisionObjectQueryParams _obstacleLayers = FCollisionObjectQueryParams(Settings.ObstacleLayers);
+	const FCollisionQueryParams _params = FCollisionQueryParams(SCENE_QUERY_STAT(NavigationMeshGeneration), false);
+	// Overlap with Obstacle Avoidance to check if Node is not too close to an Obstacle
+	if (_world->OverlapAnyTestByObjectType(_location, FQuat::Identity, _obstacleLayers, FCollisionShape::MakeBox(FVector(Settings.ObstacleAvoidanceSize)), _params))
+		return false;
+	// Overlap with Agent Height & Width (Check if Agent can pass through)
+	const FVector _agentHeightLocation = _location + FVector(0, 0, Settings.AgentHeight);
+	return !_world->OverlapAnyTestByObjectType(_agentHeightLocation, FQuat::Identity, _obstacleLayers, FCollisionShape::MakeCapsule(Settings.AgentWidth, Settings.AgentHeight), _params);
+}
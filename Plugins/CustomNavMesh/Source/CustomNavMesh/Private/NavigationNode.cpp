@@ -1,85 +1,48 @@
 #include "NavigationNode.h"
 
-#if WITH_EDITOR
-#include "Kismet/KismetMathLibrary.h"
-#include "Kismet/KismetSystemLibrary.h"
-
-#define SingleLineTrace(startLocation, endLocation, layers, result) UKismetSystemLibrary::LineTraceSingleForObjects(GetWorld(), startLocation, endLocation, layers, false, { }, EDrawDebugTrace::None, result, true);
-#define SingleBoxTrace(location, halfSize, rotation, layers, result) UKismetSystemLibrary::BoxTraceSingleForObjects(GetWorld(), location, location, halfSize, rotation, layers, false, { }, EDrawDebugTrace::None, result, true);
-#define SingleCapsuleTrace(location, width, height, layers, result) UKismetSystemLibrary::CapsuleTraceSingleForObjects(GetWorld(), location, location, width, height, layers, false, { }, EDrawDebugTrace::None, _result, true)
-
-#define MultiLineTrace(startLocation, endLocation, layers, results) UKismetSystemLibrary::LineTraceMultiForObjects(GetWorld(), startLocation, endLocation, layers, false, { }, EDrawDebugTrace::None, results, true)
-#endif
-
 void UNavigationNode::PassedBy(AActor* _actor)
 {
 	OnPassedBy.Broadcast(this, _actor);
 }
 
-#if WITH_EDITOR
 #pragma region Init
-void UNavigationNode::InitializeNavigationNodeSimple(const FVector& _location, const FNavigationMeshSettings& _navSettings)
+void UNavigationNode::InitializeNavigationNode(const FVector& _location, const bool _isAccessible)
 {
 	Location = _location;
-	const FVector& _endLocation = _location - FVector(0, 0, _navSettings.NavigationGridHeight);
-	
-	FHitResult _result;
-	// Line Trace to check if Node is above the Ground
-	IsAccessible = SingleLineTrace(Location, _endLocation, _navSettings.GroundLayers, _result);
-	if (IsAccessible)
-	{
-		Location = _result.ImpactPoint + _result.ImpactNormal * _navSettings.NavigationGridSurfaceHeight;
-		CheckLocationAccessibility(_navSettings);
-	}
-}
-
-void UNavigationNode::InitializeNavigationNodeComplex(const FVector& _location, const FNavigationMeshSettings& _navSettings)
-{
-	Location = _location;
-	const FVector& _endLocation = _location + FVector(0, 0, _navSettings.AgentHeight);
-	
-	FHitResult _result;
-	// Check if there is no Walkable ground above node (with Agent Height)
-	IsAccessible = !SingleLineTrace(Location, _endLocation, _navSettings.GroundLayers, _result);
-	if (IsAccessible)
-	{
-		CheckLocationAccessibility(_navSettings);
-	}
+	IsAccessible = _isAccessible;
 }
 
 void UNavigationNode::AddNeighbor(UNavigationNode* _node)
 {
 	if (!IsAccessible || !_node->IsNodeAccessible() || NeighborExist(_node)) return;	//Only add Neighbor if the Current Node is Accessible, the Neighbor Node is Accessible and not already add as a Neighbor 
 	Neighbors.Add(_node);
+	NeighborSet.Add(_node);
 }
 void UNavigationNode::RemoveNeighbor(UNavigationNode* _node)
 {
 	if (!NeighborExist(_node)) return;
 	Neighbors.Remove(_node);
+	NeighborSet.Remove(_node);
 }
-
-bool UNavigationNode::NeighborExist(const UNavigationNode* _node) const
+void UNavigationNode::ClearNeighbors()
 {
-	return Neighbors.Contains(_node);
+	Neighbors.Reset();
+	NeighborSet.Reset();
 }
 
-void UNavigationNode::CheckLocationAccessibility(const FNavigationMeshSettings& _navSettings)
+bool UNavigationNode::NeighborExist(const UNavigationNode* _node) const
 {
-	if (_navSettings.ObstacleLayers.IsEmpty())
-		return;
-	
-	FHitResult _result;
-	// Box Trace with Obstacle Avoidance to check if Node is not too close to an Obstacle
-	IsAccessible = !SingleBoxTrace(Location, FVector(_navSettings.ObstacleAvoidanceSize), FRotator(0), _navSettings.ObstacleLayers, _result);
-	if (IsAccessible)
+	if (NeighborSet.Num() != Neighbors.Num())
 	{
-		// Capsule Trace with Agent Height & Width (Check if Agent can pass through)
-		const FVector& _agentHeightLocation = Location + FVector(0, 0, _navSettings.AgentHeight);
-		IsAccessible = !SingleCapsuleTrace(_agentHeightLocation, _navSettings.AgentWidth, _navSettings.AgentHeight, _navSettings.ObstacleLayers, _result);
+		NeighborSet.Reset();
+		for (const UNavigationNode* _neighbor : Neighbors)
+			NeighborSet.Add(_neighbor);
 	}
+	return NeighborSet.Contains(_node);
 }
 #pragma endregion
 
+#if WITH_EDITOR
 void UNavigationNode::DrawNavigationNodeDebug(const FColor& _nodeColor, const FColor& _lineColor, const float& _drawTime) const
 {
 	const FVector& _location = NodeLocation();
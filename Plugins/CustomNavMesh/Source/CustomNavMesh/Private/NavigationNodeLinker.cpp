@@ -34,6 +34,14 @@ void ANavigationNodeLinker::BeginPlay()
 	{
 		NodeLeft->OnPassedBy.AddUniqueDynamic(this, &ANavigationNodeLinker::OnNodePassedBy);
 		NodeRight->OnPassedBy.AddUniqueDynamic(this, &ANavigationNodeLinker::OnNodePassedBy);		
+
+		if (!NodeLeft->IsNodeWaypoint() || !NodeRight->IsNodeWaypoint())		//	Linked before the waypoint flag existed
+		{
+			NodeLeft->SetNodeWaypoint(true);
+			NodeRight->SetNodeWaypoint(true);
+			if (NavigationMesh && !NavigationMesh->IsNavigationGraphBaked())
+				NavigationMesh->CompileNavigationGraph();
+		}
 	}
 }
 
@@ -56,19 +64,74 @@ void ANavigationNodeLinker::Destroyed()
 
 void ANavigationNodeLinker::OnNodePassedBy(UNavigationNode* _node, AActor* _actor)
 {
-	if (!_actor || !_node) return;
+	if (!_actor || !_node || !NodeLeft || !NodeRight) return;
 	
 	if (const UNavigationAgentComponent* _compo = Cast<UNavigationAgentComponent>(_actor->GetComponentByClass(UNavigationAgentComponent::StaticClass())))
 	{
-		const UNavigationNode* _agentTargetNode = _compo->AgentTargetNode();
+		const int _agentTargetNode = _compo->AgentTargetNode();
 		
-		if (_agentTargetNode == NodeLeft)
+		if (_agentTargetNode == NodeLeft->NodeIndex())
 			OnLinkedNodeReached(_actor, NodeLeft->NodeLocation());
-		if (_agentTargetNode == NodeRight)
+		if (_agentTargetNode == NodeRight->NodeIndex())
 			OnLinkedNodeReached(_actor, NodeRight->NodeLocation());
 	}
 }
 
+#pragma region Link
+void ANavigationNodeLinker::RestoreNodeLink()
+{
+	if (!NavigationMesh || !NodeLeft || !NodeRight) return;
+
+	if (NavigationMesh->GetNavigationNode(NodeLeft->NodeIndex()) != NodeLeft || NavigationMesh->GetNavigationNode(NodeRight->NodeIndex()) != NodeRight)
+	{
+#if WITH_EDITOR
+		UNavigationNode* _nodeLeft = NavigationMesh->GetClosestNode(LinkLeft->GetComponentLocation());		//	Ground of a linked Node removed : link the closest ones
+		UNavigationNode* _nodeRight = NavigationMesh->GetClosestNode(LinkRight->GetComponentLocation());
+		NodeLeft = _nodeLeft != _nodeRight ? _nodeLeft : nullptr;
+		NodeRight = _nodeLeft != _nodeRight ? _nodeRight : nullptr;
+#else
+		NodeLeft = NodeRight = nullptr;
+#endif
+		if (!NodeLeft || !NodeRight)
+		{
+			LOG("WARNING : Node of the link %s was removed by a Navigation Mesh rebuild, the link is cleared", *GetName());
+			NodeLeft = NodeRight = nullptr;
+			return;
+		}
+		if (HasActorBegunPlay())
+		{
+			NodeLeft->OnPassedBy.AddUniqueDynamic(this, &ANavigationNodeLinker::OnNodePassedBy);
+			NodeRight->OnPassedBy.AddUniqueDynamic(this, &ANavigationNodeLinker::OnNodePassedBy);
+		}
+	}
+	InitNeighbors(LinkWay);
+}
+
+void ANavigationNodeLinker::InitNeighbors(const ENodeLink& _link) const
+{
+	if (NodeLeft && NodeRight)
+	{
+		NodeLeft->SetNodeWaypoint(true);
+		NodeRight->SetNodeWaypoint(true);
+		switch (_link)
+		{
+		default :
+			break;
+		case ENodeLink::LinkLR :
+			NodeLeft->AddNeighbor(NodeRight);
+			break;
+		case ENodeLink::LinkRL :
+			NodeRight->AddNeighbor(NodeLeft);			
+			break;
+		case ENodeLink::LinkBoth :
+			NodeLeft->AddNeighbor(NodeRight);
+			NodeRight->AddNeighbor(NodeLeft);			
+			break;
+		}
+	}
+}
+#pragma endregion
+
 #if WITH_EDITOR
 #pragma region Init
 void ANavigationNodeLinker::InitNodeLink()
@@ -76,32 +139,39 @@ void ANavigationNodeLinker::InitNodeLink()
 	if (!NavigationMesh) return;
 
 	NavigationMesh->OnNavMeshGeneration.AddUniqueDynamic(this, &ANavigationNodeLinker::InitNodeLink);
+	if (NavigationMesh->IsNavigationGraphBaked())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("WARNING : Navigation Mesh is baked, unbake it to edit its Node links"));
+		return;
+	}
 
 	UNavigationNode* _nodeLeft = NavigationMesh->GetClosestNode(LinkLeft->GetComponentLocation());
 	UNavigationNode* _nodeRight = NavigationMesh->GetClosestNode(LinkRight->GetComponentLocation());
 
-	if (_nodeLeft->NeighborExist(_nodeRight) || _nodeRight->NeighborExist(_nodeLeft) || _nodeLeft == _nodeRight) return;
+	if (!_nodeLeft || !_nodeRight || _nodeLeft->NeighborExist(_nodeRight) || _nodeRight->NeighborExist(_nodeLeft) || _nodeLeft == _nodeRight) return;
 	
-	if (_nodeLeft && _nodeRight)
-	{
-		RemoveNeighbors(LinkWay);
-		
-		NodeLeft = _nodeLeft;
-		NodeRight = _nodeRight;
-		InitNeighbors(LinkWay);
-	}
+	RemoveNeighbors(LinkWay);
+	
+	NodeLeft = _nodeLeft;
+	NodeRight = _nodeRight;
+	InitNeighbors(LinkWay);
+	NavigationMesh->CompileNavigationGraph();
 }
 void ANavigationNodeLinker::ClearNodeLink()
 {
 	RemoveNeighbors(LinkWay);
 	NodeLeft = nullptr;
 	NodeRight = nullptr;
+	if (NavigationMesh)
+		NavigationMesh->CompileNavigationGraph();
 }
 
 void ANavigationNodeLinker::RemoveNeighbors(const ENodeLink& _link) const
 {
 	if (NodeLeft && NodeRight)
 	{
+		NodeLeft->SetNodeWaypoint(false);
+		NodeRight->SetNodeWaypoint(false);
 		switch (_link)
 		{
 		default :
@@ -119,27 +189,6 @@ void ANavigationNodeLinker::RemoveNeighbors(const ENodeLink& _link) const
 		}
 	}
 }
-void ANavigationNodeLinker::InitNeighbors(const ENodeLink& _link) const
-{
-	if (NodeLeft && NodeRight)
-	{
-		switch (_link)
-		{
-		default :
-			break;
-		case ENodeLink::LinkLR :
-			NodeLeft->AddNeighbor(NodeRight);
-			break;
-		case ENodeLink::LinkRL :
-			NodeRight->AddNeighbor(NodeLeft);			
-			break;
-		case ENodeLink::LinkBoth :
-			NodeLeft->AddNeighbor(NodeRight);
-			NodeRight->AddNeighbor(NodeLeft);			
-			break;
-		}
-	}
-}
 #pragma endregion
 
 #pragma region Edit
@@ -151,6 +200,8 @@ void ANavigationNodeLinker::PostEditChangeProperty(FPropertyChangedEvent& Proper
 	{
 		RemoveNeighbors(LinkWayOld);
 		InitNeighbors(LinkWay);
+		if (NavigationMesh)
+			NavigationMesh->CompileNavigationGraph();
 	}
 
 	if (NavigationMeshOld != NavigationMesh)
@@ -160,7 +211,10 @@ void ANavigationNodeLinker::PostEditChangeProperty(FPropertyChangedEvent& Proper
 		NodeRight = nullptr;
 
 		if (NavigationMeshOld)
+		{
 			NavigationMeshOld->OnNavMeshGeneration.RemoveDynamic(this, &ANavigationNodeLinker::InitNodeLink);
+			NavigationMeshOld->CompileNavigationGraph();
+		}
 		if (NavigationMesh)
 			NavigationMesh->OnNavMeshGeneration.AddUniqueDynamic(this, &ANavigationNodeLinker::InitNodeLink);
 	}
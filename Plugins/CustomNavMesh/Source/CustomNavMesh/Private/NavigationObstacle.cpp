@@ -0,0 +1,95 @@
+#include "NavigationObstacle.h"
+
+int FNavigationObstacleSet::Add(const FNavigationObstacleShape& _shape)
+{
+	const int _id = Obstacles.Add(FObstacle());
+	Obstacles[_id].Shape = _shape;
+	Stamp(Obstacles[_id]);
+	return _id;
+}
+
+void FNavigationObstacleSet::Update(const int _id, const FNavigationObstacleShape& _shape)
+{
+	if (!Obstacles.IsValidIndex(_id)) return;
+
+	FObstacle& _obstacle = Obstacles[_id];
+	const TArray<int> _previous = MoveTemp(_obstacle.Nodes);
+	_obstacle.Shape = _shape;
+	Stamp(_obstacle);			//	New stamp first : Nodes still inside never reach a count of 0, so they don't flip
+	Unstamp(_previous);
+}
+
+void FNavigationObstacleSet::Remove(const int _id)
+{
+	if (!Obstacles.IsValidIndex(_id)) return;
+
+	Unstamp(Obstacles[_id].Nodes);
+	Obstacles.RemoveAt(_id);
+}
+
+void FNavigationObstacleSet::SetGraph(const FNavigationGraphPtr& _graph)
+{
+	Graph = _graph;
+	const int _max = Graph ? Graph->NodeCount() : 0;
+	const bool _wasBlocked = BlockedCount > 0;
+	BlockCount.Init(0, _max);
+	Blocked.Init(false, _max);
+	BlockedCount = 0;
+
+	for (FObstacle& _obstacle : Obstacles)
+	{
+		_obstacle.Nodes.Reset();
+		Stamp(_obstacle);
+	}
+	if (_wasBlocked)			//	Node indices of the new graph can differ
+		Version++;
+}
+
+FNavigationBlockedNodesPtr FNavigationObstacleSet::GetSnapshot()
+{
+	if (BlockedCount == 0) return nullptr;
+	if (Snapshot && Snapshot->Version == Version) return Snapshot;
+
+	//	Copied once per version : running searches keep the snapshot they started with
+	const TSharedRef<FNavigationBlockedNodes, ESPMode::ThreadSafe> _snapshot = MakeShared<FNavigationBlockedNodes, ESPMode::ThreadSafe>();
+	_snapshot->Blocked = Blocked;
+	_snapshot->Version = Version;
+	Snapshot = _snapshot;
+	return Snapshot;
+}
+
+void FNavigationObstacleSet::Stamp(FObstacle& _obstacle)
+{
+	if (!Graph) return;
+
+	const FBox& _bounds = _obstacle.Shape.GetBounds();
+	Graph->SpatialIndex.FindNodesInBox(*Graph, FBox2D(FVector2D(_bounds.Min), FVector2D(_bounds.Max)), Candidates);
+
+	bool _changed = false;
+	for (const int _node : Candidates)
+	{
+		if (!_obstacle.Shape.Contains(Graph->NodeLocation(_node))) continue;
+
+		_obstacle.Nodes.Add(_node);
+		if (BlockCount[_node]++ > 0) continue;
+		Blocked[_node] = true;
+		BlockedCount++;
+		_changed = true;
+	}
+	if (_changed)
+		Version++;
+}
+
+void FNavigationObstacleSet::Unstamp(const TArray<int>& _nodes)
+{
+	bool _changed = false;
+	for (const int _node : _nodes)
+	{
+		if (!BlockCount.IsValidIndex(_node) || BlockCount[_node] == 0 || --BlockCount[_node] > 0) continue;
+		Blocked[_node] = false;
+		BlockedCount--;
+		_changed = true;
+	}
+	if (_changed)
+		Version++;
+}
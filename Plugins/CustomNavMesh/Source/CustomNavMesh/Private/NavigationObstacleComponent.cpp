@@ -0,0 +1,120 @@
+#include "NavigationObstacleComponent.h"
+
+#include "EngineUtils.h"
+
+#include "NavigationMesh.h"
+
+UNavigationObstacleComponent::UNavigationObstacleComponent()
+{
+	bWantsOnUpdateTransform = true;			//	Moves are caught in OnUpdateTransform, no tick needed
+	PrimaryComponentTick.bCanEverTick = false;
+
+#if WITH_EDITOR
+	PrimaryComponentTick.bCanEverTick = true;	//	Debug only
+	bTickInEditor = true;
+#endif
+}
+
+void UNavigationObstacleComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (!NavigationMesh)
+	{
+		TActorIterator<ANavigationMesh> _it(GetWorld());
+		NavigationMesh = _it ? *_it : nullptr;
+	}
+	if (ObstacleEnable)
+		RegisterObstacle();
+}
+void UNavigationObstacleComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UnregisterObstacle();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UNavigationObstacleComponent::OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	Super::OnUpdateTransform(UpdateTransformFlags, Teleport);
+
+	UpdateObstacle(false);
+}
+
+#if WITH_EDITOR
+void UNavigationObstacleComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (!Debug) return;
+
+	const FTransform& _transform = GetComponentTransform();
+	const FColor& _color = IsObstacleRegistered() || !GetWorld()->IsGameWorld() ? ObstacleDebugColor : FColor::Silver;
+	if (Shape == ENavigationObstacleShape::ObstacleCylinder)
+	{
+		const FVector& _up = _transform.GetUnitAxis(EAxis::Z) * CylinderHalfHeight * _transform.GetScale3D().Z;
+		DrawDebugCylinder(GetWorld(), _transform.GetLocation() - _up, _transform.GetLocation() + _up, CylinderRadius * _transform.GetScale3D().X, 16, _color);
+		return;
+	}
+	DrawDebugBox(GetWorld(), _transform.GetLocation(), BoxExtent * _transform.GetScale3D(), _transform.GetRotation(), _color);
+}
+#endif
+
+void UNavigationObstacleComponent::SetObstacleEnable(const bool _enable)
+{
+	ObstacleEnable = _enable;
+	if (!HasBegunPlay()) return;
+
+	if (ObstacleEnable)
+		RegisterObstacle();
+	else
+		UnregisterObstacle();
+}
+
+void UNavigationObstacleComponent::SetBoxExtent(const FVector& _extent)
+{
+	BoxExtent = _extent.ComponentMax(FVector::ZeroVector);
+	UpdateObstacle(true);
+}
+void UNavigationObstacleComponent::SetCylinderSize(const float _radius, const float _halfHeight)
+{
+	CylinderRadius = FMath::Max(_radius, 0.0f);
+	CylinderHalfHeight = FMath::Max(_halfHeight, 0.0f);
+	UpdateObstacle(true);
+}
+
+FNavigationObstacleShape UNavigationObstacleComponent::GetObstacleShape() const
+{
+	if (Shape == ENavigationObstacleShape::ObstacleCylinder)
+		return FNavigationObstacleShape(GetComponentTransform(), FVector(CylinderRadius, CylinderRadius, CylinderHalfHeight), true);
+	return FNavigationObstacleShape(GetComponentTransform(), BoxExtent, false);
+}
+
+void UNavigationObstacleComponent::RegisterObstacle()
+{
+	if (IsObstacleRegistered() || !NavigationMesh) return;
+
+	StampedTransform = GetComponentTransform();
+	ObstacleId = NavigationMesh->AddNavigationObstacle(GetObstacleShape());
+}
+void UNavigationObstacleComponent::UnregisterObstacle()
+{
+	if (!IsObstacleRegistered()) return;
+
+	if (NavigationMesh)
+		NavigationMesh->RemoveNavigationObstacle(ObstacleId);
+	ObstacleId = INDEX_NONE;
+}
+
+void UNavigationObstacleComponent::UpdateObstacle(const bool _force)
+{
+	if (!IsObstacleRegistered() || !NavigationMesh) return;
+
+	const FTransform& _transform = GetComponentTransform();
+	if (!_force && FVector::DistSquared(_transform.GetLocation(), StampedTransform.GetLocation()) < UpdateDistance * UpdateDistance
+		&& _transform.GetRotation().Equals(StampedTransform.GetRotation(), 0.01f) && _transform.GetScale3D().Equals(StampedTransform.GetScale3D(), 0.01f))
+		return;
+
+	StampedTransform = _transform;
+	NavigationMesh->UpdateNavigationObstacle(ObstacleId, GetObstacleShape());
+}
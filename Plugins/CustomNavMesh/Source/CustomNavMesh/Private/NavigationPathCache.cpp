@@ -0,0 +1,133 @@
+#include "NavigationPathCache.h"
+
+void FNavigationPathCache::SetCapacity(const int _capacity)
+{
+	if (_capacity == Capacity) return;
+
+	Capacity = FMath::Max(0, _capacity);
+	Empty();
+}
+
+void FNavigationPathCache::Empty()
+{
+	Entries.Reset();
+	EntryByKey.Reset();
+	EntriesByEnd.Reset();
+	MostRecent = INDEX_NONE;
+	LeastRecent = INDEX_NONE;
+}
+
+bool FNavigationPathCache::Find(const uint32 _version, const uint8 _mode, const bool _isOptimal, const int _startNode, const int _endNode, TArray<int>& _outPath)
+{
+	CheckVersion(_version);
+	if (Capacity <= 0) return false;
+
+	if (const int* _entry = EntryByKey.Find(MakeKey(_startNode, _endNode, _mode)))
+	{
+		_outPath = Entries[*_entry].Path;
+		Touch(*_entry);
+		Hits++;
+		return true;
+	}
+
+	//	Sub path : a cached optimal path to the same End Node going through the Start Node (any optimal mode gives the same cost)
+	TArray<int> _candidates = { };
+	if (_isOptimal)
+		EntriesByEnd.MultiFind(_endNode, _candidates);
+	for (const int _candidate : _candidates)
+	{
+		const TArray<int>& _path = Entries[_candidate].Path;
+		const int _index = _path.Find(_startNode);
+		if (_index == INDEX_NONE) continue;
+
+		_outPath = TArray<int>(_path.GetData() + _index, _path.Num() - _index);
+		Touch(_candidate);
+		SubPathHits++;
+		return true;
+	}
+
+	Misses++;
+	return false;
+}
+
+void FNavigationPathCache::Add(const uint32 _version, const uint8 _mode, const bool _isOptimal, const TArray<int>& _path)
+{
+	if (_version < Version) return;		//	Computed on older navigation data
+	CheckVersion(_version);
+	if (Capacity <= 0 || _path.IsEmpty()) return;
+
+	const int _startNode = _path[0];
+	const int _endNode = _path.Last();
+	const FKey _key = MakeKey(_startNode, _endNode, _mode);
+	if (const int* _existing = EntryByKey.Find(_key))
+	{
+		Touch(*_existing);
+		return;
+	}
+
+	int _entry = INDEX_NONE;
+	if (Entries.Num() < Capacity)
+		_entry = Entries.AddDefaulted();
+	else									//	Full : recycle the least recently used entry
+	{
+		_entry = LeastRecent;
+		Unlink(_entry);
+		const FEntry& _old = Entries[_entry];
+		EntryByKey.Remove(MakeKey(_old.StartNode, _old.EndNode, _old.Mode));
+		if (_old.IsOptimal)
+			EntriesByEnd.RemoveSingle(_old.EndNode, _entry);
+	}
+
+	FEntry& _new = Entries[_entry];
+	_new.StartNode = _startNode;
+	_new.EndNode = _endNode;
+	_new.Mode = _mode;
+	_new.IsOptimal = _isOptimal;
+	_new.Path = _path;
+	EntryByKey.Add(_key, _entry);
+	if (_isOptimal)
+		EntriesByEnd.Add(_endNode, _entry);
+	LinkFront(_entry);
+}
+
+void FNavigationPathCache::CheckVersion(const uint32 _version)
+{
+	if (_version == Version) return;
+
+	Empty();
+	Version = _version;
+}
+
+void FNavigationPathCache::Unlink(const int _entry)
+{
+	FEntry& _current = Entries[_entry];
+	if (_current.Previous != INDEX_NONE)
+		Entries[_current.Previous].Next = _current.Next;
+	else
+		MostRecent = _current.Next;
+	if (_current.Next != INDEX_NONE)
+		Entries[_current.Next].Previous = _current.Previous;
+	else
+		LeastRecent = _current.Previous;
+	_current.Previous = _current.Next = INDEX_NONE;
+}
+
+void FNavigationPathCache::LinkFront(const int _entry)
+{
+	FEntry& _current = Entries[_entry];
+	_current.Previous = INDEX_NONE;
+	_current.Next = MostRecent;
+	if (MostRecent != INDEX_NONE)
+		Entries[MostRecent].Previous = _entry;
+	MostRecent = _entry;
+	if (LeastRecent == INDEX_NONE)
+		LeastRecent = _entry;
+}
+
+void FNavigationPathCache::Touch(const int _entry)
+{
+	if (_entry == MostRecent) return;
+
+	Unlink(_entry);
+	LinkFront(_entry);
+}
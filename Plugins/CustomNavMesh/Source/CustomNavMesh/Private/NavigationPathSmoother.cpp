@@ -0,0 +1,74 @@
+#include "NavigationPathSmoother.h"
+
+#include "NavigationRaycast.h"
+
+void FNavigationPathSmoother::SetCapacity(const int _capacity)
+{
+	Capacity = FMath::Max(_capacity, 0);
+	if (Visibility.Num() > Capacity)
+		Visibility.Reset();
+}
+void FNavigationPathSmoother::Empty()
+{
+	Visibility.Reset();
+	Tests = 0;
+	CachedTests = 0;
+}
+
+void FNavigationPathSmoother::SmoothPath(const FNavigationGraph& _graph, const uint32 _version, const FNavigationBlockedNodes* _blocked, FNavigationNodePath& _path)
+{
+	if (_version != Version)
+	{
+		Visibility.Reset();
+		Version = _version;
+	}
+
+	const TArray<int>& _nodes = _path.NodePath;
+	const int _max = _nodes.Num();
+	if (_max < 3 || _path.NodeLocations.Num() != _max) return;
+	for (int i = 0; i < _max; ++i)
+		if (!_graph.IsValidNode(_nodes[i]) || !_graph.NodeLocation(_nodes[i]).Equals(_path.NodeLocations[i]))
+			return;		//	Path of another graph
+
+	TArray<int> _kept = { 0 };
+	int _anchor = 0;
+	for (int i = 2; i < _max; ++i)
+	{
+		const int _previous = i - 1;
+		if (!_graph.IsNodeWaypoint(_nodes[_previous]) && IsVisible(_graph, _nodes[_anchor], _nodes[i], _blocked)) continue;
+
+		_kept.Add(_previous);
+		_anchor = _previous;
+	}
+	_kept.Add(_max - 1);
+	if (_kept.Num() == _max) return;
+
+	TArray<int> _smoothNodes = { };
+	TArray<FVector> _smoothLocations = { };
+	_smoothNodes.Reserve(_kept.Num());
+	_smoothLocations.Reserve(_kept.Num());
+	for (const int _index : _kept)
+	{
+		_smoothNodes.Add(_nodes[_index]);
+		_smoothLocations.Add(_path.NodeLocations[_index]);
+	}
+	_path = FNavigationNodePath(_smoothNodes, _smoothLocations);
+}
+
+bool FNavigationPathSmoother::IsVisible(const FNavigationGraph& _graph, const int _fromNode, const int _toNode, const FNavigationBlockedNodes* _blocked)
+{
+	Tests++;
+	const uint64 _key = static_cast<uint64>(static_cast<uint32>(_fromNode)) << 32 | static_cast<uint32>(_toNode);
+	if (const bool* _visible = Visibility.Find(_key))
+	{
+		CachedTests++;
+		return *_visible;
+	}
+
+	const bool _visible = FNavigationRaycast::IsWalkable(_graph, _fromNode, _toNode, _blocked);
+	if (Capacity == 0) return _visible;
+	if (Visibility.Num() >= Capacity)
+		Visibility.Reset();		//	Pairs of old paths are as likely as any other to come back
+	Visibility.Add(_key, _visible);
+	return _visible;
+}
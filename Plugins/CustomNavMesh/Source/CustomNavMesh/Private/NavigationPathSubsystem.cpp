@@ -0,0 +1,231 @@
+#include "NavigationPathSubsystem.h"
+
+#include "Async/Async.h"
+
+#include "NavigationAlgorithm.h"
+
+#pragma region Workers
+TUniquePtr<FNavigationSearch> FNavigationPathQueryWorkers::AcquireSearch()
+{
+	FScopeLock _lock(&SearchPoolLock);
+	return SearchPool.IsEmpty() ? MakeUnique<FNavigationSearch>() : SearchPool.Pop(false);
+}
+void FNavigationPathQueryWorkers::ReleaseSearch(TUniquePtr<FNavigationSearch> _search)
+{
+	FScopeLock _lock(&SearchPoolLock);
+	SearchPool.Add(MoveTemp(_search));
+}
+#pragma endregion
+
+#pragma region Queries
+FNavigationPathQueryHandle UNavigationPathSubsystem::RequestPath(const FNavigationPathRequest& _request, const UObject* _owner, const FOnNavigationPathQueryCompleted& _onCompleted)
+{
+	FNavigationPathQueryHandle _handle;
+	const FNavigationPathQueryPtr _query = CreateQuery(_request, _owner, _onCompleted);
+	if (!_query) return _handle;
+
+	RunQueryAsync(_query);
+	_handle.Id = _query->Id;
+	return _handle;
+}
+
+void UNavigationPathSubsystem::RunQueryAsync(const FNavigationPathQueryPtr& _query)
+{
+	Async(EAsyncExecution::ThreadPool, [_query, _workers = Workers]()
+	{
+		if (!_query->Cancelled.load(std::memory_order_relaxed))
+		{
+			TUniquePtr<FNavigationSearch> _search = _workers->AcquireSearch();
+			TArray<int> _path = { };
+			_query->Success = _search->FindPath(_query->Request, _path, &_query->Cancelled) && !_path.IsEmpty();
+			if (_query->Success)
+				_query->Path = UAlgorithmAStar::GetPath(*_query->Request.Graph, _path);
+			_workers->ReleaseSearch(MoveTemp(_search));
+		}
+		_workers->Completed.Enqueue(_query);
+	});
+}
+
+FNavigationPathQueryHandle UNavigationPathSubsystem::RequestPathTimeSliced(const FNavigationPathRequest& _request, const UObject* _owner, const uint8 _priority, const FOnNavigationPathQueryCompleted& _onCompleted)
+{
+	FNavigationPathQueryHandle _handle;
+	const FNavigationPathQueryPtr _query = CreateQuery(_request, _owner, _onCompleted);
+	if (!_query) return _handle;
+
+	_handle.Id = _query->Id;
+	if (!_request.IsSteppable())			//	Would run to completion in its first slice, whatever the budget
+	{
+		RunQueryAsync(_query);
+		return _handle;
+	}
+
+	_query->Priority = _priority;
+	_query->Search = Workers->AcquireSearch();
+	_query->Search->Begin(*_request.Graph, _request.StartNode, _request.EndNode, _query->Request.BlockedNodes.Get());	//	Snapshot kept alive by the query
+	TimeSlicedQueries.Add(_query);
+
+	return _handle;
+}
+
+FNavigationPathQueryPtr UNavigationPathSubsystem::CreateQuery(const FNavigationPathRequest& _request, const UObject* _owner, const FOnNavigationPathQueryCompleted& _onCompleted)
+{
+	if (!_request.IsValid() || !Workers) return nullptr;
+
+	if (_owner)
+		if (const uint32* _previous = OwnerQueries.Find(_owner))	//	Supersede the previous query of this owner
+		{
+			FNavigationPathQueryHandle _previousHandle;
+			_previousHandle.Id = *_previous;
+			CancelQuery(_previousHandle);
+		}
+
+	FNavigationPathQueryPtr _query = MakeShared<FNavigationPathQuery, ESPMode::ThreadSafe>();
+	_query->Id = NextQueryId++;
+	if (NextQueryId == 0)
+		NextQueryId = 1;
+	_query->Request = _request;
+	_query->Owner = _owner;
+	_query->OnCompleted = _onCompleted;
+
+	PendingQueries.Add(_query->Id, _query);
+	if (_owner)
+		OwnerQueries.Add(_owner, _query->Id);
+	return _query;
+}
+
+void UNavigationPathSubsystem::CancelQuery(const FNavigationPathQueryHandle& _handle)
+{
+	FNavigationPathQueryPtr _query = nullptr;
+	if (!PendingQueries.RemoveAndCopyValue(_handle.Id, _query)) return;
+
+	_query->Cancelled = true;		//	Worker stops at its next check, the result is dropped when it comes back
+	ForgetQuery(*_query);
+}
+
+bool UNavigationPathSubsystem::IsQueryPending(const FNavigationPathQueryHandle& _handle) const
+{
+	return PendingQueries.Contains(_handle.Id);
+}
+
+void UNavigationPathSubsystem::ProcessCompletedQueries()
+{
+	FNavigationPathQueryPtr _query = nullptr;
+	while (Workers->Completed.Dequeue(_query))
+	{
+		if (_query->Cancelled) continue;
+
+		PendingQueries.Remove(_query->Id);
+		ForgetQuery(*_query);
+		_query->OnCompleted.ExecuteIfBound(_query->Success, _query->Path);
+	}
+}
+
+void UNavigationPathSubsystem::ProcessTimeSlicedQueries()
+{
+	LastFrameSearchSeconds = 0;
+	TimeSlicedQueries.RemoveAll([this](const FNavigationPathQueryPtr& _query)
+	{
+		if (!_query->Cancelled) return false;
+		Workers->ReleaseSearch(MoveTemp(_query->Search));
+		return true;
+	});
+	if (TimeSlicedQueries.IsEmpty()) return;
+
+	//	Highest priority first, then the ones which waited the longest
+	TimeSlicedQueries.Sort([](const FNavigationPathQueryPtr& _a, const FNavigationPathQueryPtr& _b)
+	{
+		if (_a->Priority != _b->Priority) return _a->Priority > _b->Priority;
+		return _a->LastServedFrame < _b->LastServedFrame;
+	});
+
+	int _remainingWeight = 0;
+	for (const FNavigationPathQueryPtr& _query : TimeSlicedQueries)
+		_remainingWeight += 1 + _query->Priority;
+
+	const double _startTime = FPlatformTime::Seconds();
+	const double _endTime = _startTime + FrameBudgetSeconds;
+	TArray<FNavigationPathQueryPtr> _completed = { };
+	const int _max = TimeSlicedQueries.Num();
+	for (int i = 0; i < _max; ++i)
+	{
+		const double _now = FPlatformTime::Seconds();
+		if (_now >= _endTime) break;				//	Budget spent, remaining queries are served first next frame
+
+		const FNavigationPathQueryPtr& _query = TimeSlicedQueries[i];
+		const int _weight = 1 + _query->Priority;
+		const double _slice = (_endTime - _now) * _weight / _remainingWeight;		//	Share of what is left, unused time goes to the next queries
+		_remainingWeight -= _weight;
+
+		_query->LastServedFrame = GFrameCounter;
+		if (_query->Search->Step(MAX_int32, _slice) == ENavigationSearchStatus::InProgress) continue;
+
+		TArray<int> _path = { };
+		_query->Search->GetPath(_path);
+		_query->Success = _query->Search->SearchStatus() == ENavigationSearchStatus::Succeeded && !_path.IsEmpty();
+		if (_query->Success)
+			_query->Path = UAlgorithmAStar::GetPath(*_query->Request.Graph, _path);
+		_completed.Add(_query);
+	}
+	LastFrameSearchSeconds = FPlatformTime::Seconds() - _startTime;
+
+	for (const FNavigationPathQueryPtr& _query : _completed)
+	{
+		TimeSlicedQueries.Remove(_query);
+		Workers->ReleaseSearch(MoveTemp(_query->Search));
+		PendingQueries.Remove(_query->Id);
+		ForgetQuery(*_query);
+	}
+	for (const FNavigationPathQueryPtr& _query : _completed)		//	Callbacks last : they can request or cancel queries
+		if (!_query->Cancelled)
+			_query->OnCompleted.ExecuteIfBound(_query->Success, _query->Path);
+}
+
+void UNavigationPathSubsystem::SetFrameBudget(const float _milliseconds)
+{
+	FrameBudgetSeconds = FMath::Max(0.01f, _milliseconds) / 1000.0;
+}
+
+void UNavigationPathSubsystem::ForgetQuery(const FNavigationPathQuery& _query)
+{
+	if (!_query.Owner) return;
+
+	const uint32* _ownerQuery = OwnerQueries.Find(_query.Owner);
+	if (_ownerQuery && *_ownerQuery == _query.Id)
+		OwnerQueries.Remove(_query.Owner);
+}
+#pragma endregion
+
+#pragma region Subsystem
+void UNavigationPathSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Workers = MakeShared<FNavigationPathQueryWorkers, ESPMode::ThreadSafe>();
+}
+void UNavigationPathSubsystem::Deinitialize()
+{
+	for (const TPair<uint32, FNavigationPathQueryPtr>& _query : PendingQueries)
+		_query.Value->Cancelled = true;
+	PendingQueries.Empty();
+	OwnerQueries.Empty();
+	TimeSlicedQueries.Empty();
+	Workers = nullptr;				//	Running workers keep their own reference
+
+	Super::Deinitialize();
+}
+
+void UNavigationPathSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!Workers) return;
+
+	ProcessCompletedQueries();
+	ProcessTimeSlicedQueries();
+}
+
+TStatId UNavigationPathSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UNavigationPathSubsystem, STATGROUP_Tickables);
+}
+#pragma endregion
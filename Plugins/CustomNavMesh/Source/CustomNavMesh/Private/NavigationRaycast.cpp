@@ -0,0 +1,205 @@
+#include "NavigationRaycast.h"
+
+namespace NavigationRaycast
+{
+	FORCEINLINE bool IsOpen(const FNavigationGraph& _graph, const int _node, const FNavigationBlockedNodes* _blocked)
+	{
+		return _graph.IsValidNode(_node) && _graph.IsNodeAccessible(_node) && !(_blocked && _blocked->IsBlocked(_node));
+	}
+	FORCEINLINE float GetGap(const FNavigationGraph& _graph)
+	{
+		return _graph.Layout.Gap > 0 ? _graph.Layout.Gap : 100;
+	}
+	//	One Node per cell, Node index = X * SizeY + Y
+	FORCEINLINE bool IsGridIndexed(const FNavigationGraph& _graph)
+	{
+		const FNavigationGridLayout& _layout = _graph.Layout;
+		return _layout.IsSimpleGrid && _layout.Gap > 0 && static_cast<int64>(_layout.SizeX) * _layout.SizeY == _graph.NodeCount();
+	}
+
+	/**
+	 * DDA over the cells of a simple grid (cell of a Node centered on it), the ray moves to one side neighbor at a time
+	 *
+	 * @param _canStartBlocked		The Node under _start can be blocked (Agent already inside an obstacle)
+	 */
+	bool TraverseGrid(const FNavigationGraph& _graph, const FVector2D& _start, const FVector2D& _end, const FNavigationBlockedNodes* _blocked, const bool _canStartBlocked, FNavigationRaycastHit& _outHit)
+	{
+		const FNavigationGridLayout& _layout = _graph.Layout;
+		auto _nodeAt = [&_layout](const int _x, const int _y)
+		{
+			return _x >= 0 && _y >= 0 && _x < _layout.SizeX && _y < _layout.SizeY ? _x * _layout.SizeY + _y : INDEX_NONE;
+		};
+
+		const FVector2D _origin(_layout.Origin);
+		const FVector2D _a = (_start - _origin) / _layout.Gap + FVector2D(0.5f);		//	Cell x covers [x, x + 1)
+		const FVector2D _b = (_end - _origin) / _layout.Gap + FVector2D(0.5f);
+		int _x = FMath::FloorToInt(_a.X);
+		int _y = FMath::FloorToInt(_a.Y);
+		int _node = _nodeAt(_x, _y);
+		if (!IsOpen(_graph, _node, _canStartBlocked ? nullptr : _blocked))
+		{
+			_outHit.HitNode = _node;
+			_outHit.Fraction = 0;
+			return false;
+		}
+
+		const FVector2D _delta = _b - _a;
+		const int _stepX = _delta.X > 0 ? 1 : -1;
+		const int _stepY = _delta.Y > 0 ? 1 : -1;
+		const float _tDeltaX = _delta.X != 0 ? FMath::Abs(1 / _delta.X) : UE_MAX_FLT;
+		const float _tDeltaY = _delta.Y != 0 ? FMath::Abs(1 / _delta.Y) : UE_MAX_FLT;
+		float _tMaxX = _delta.X > 0 ? (_x + 1 - _a.X) / _delta.X : _delta.X < 0 ? (_a.X - _x) / -_delta.X : UE_MAX_FLT;
+		float _tMaxY = _delta.Y > 0 ? (_y + 1 - _a.Y) / _delta.Y : _delta.Y < 0 ? (_a.Y - _y) / -_delta.Y : UE_MAX_FLT;
+
+		const int _steps = FMath::Abs(FMath::FloorToInt(_b.X) - _x) + FMath::Abs(FMath::FloorToInt(_b.Y) - _y);
+		for (int s = 0; s < _steps; ++s)
+		{
+			float _t = 0;
+			if (_tMaxX < _tMaxY)
+			{
+				_t = _tMaxX;
+				_x += _stepX;
+				_tMaxX += _tDeltaX;
+			}
+			else
+			{
+				_t = _tMaxY;
+				_y += _stepY;
+				_tMaxY += _tDeltaY;
+			}
+
+			const int _next = _nodeAt(_x, _y);
+			if (!IsOpen(_graph, _next, _blocked) || _graph.FindEdge(_node, _next) == INDEX_NONE)
+			{
+				_outHit.LastNode = _node;
+				_outHit.HitNode = _next;
+				_outHit.Fraction = FMath::Clamp(_t, 0.0f, 1.0f);
+				return false;
+			}
+			_node = _next;
+		}
+		_outHit.LastNode = _node;
+		return true;
+	}
+
+	//	Walk from _startNode along the segment until _endNode is a neighbor (complex grids, or any graph without a grid index)
+	bool WalkNeighbors(const FNavigationGraph& _graph, const int _startNode, const int _endNode, const FVector2D& _start, const FVector2D& _end, const FNavigationBlockedNodes* _blocked, FNavigationRaycastHit& _outHit)
+	{
+		const FVector2D _segment = _end - _start;
+		const float _length = _segment.Size();
+		if (_startNode == _endNode || (_length <= UE_KINDA_SMALL_NUMBER && _endNode != INDEX_NONE))
+		{
+			_outHit.LastNode = _startNode;
+			if (_startNode == _endNode || _graph.FindEdge(_startNode, _endNode) != INDEX_NONE) return true;		//	Stacked Nodes (other floor) : only a direct edge joins them
+			_outHit.HitNode = _endNode;
+			_outHit.Fraction = 0;
+			return false;
+		}
+		if (_length <= UE_KINDA_SMALL_NUMBER)
+		{
+			_outHit.LastNode = _startNode;
+			_outHit.Fraction = 0;
+			return false;
+		}
+
+		const FVector2D _direction = _segment / _length;
+		const float _gap = GetGap(_graph);
+		const float _corridor = _gap * 0.75f;
+		const int _maxSteps = FMath::CeilToInt(_length / (_gap * 0.5f)) + 8;
+
+		int _node = _startNode;
+		float _progress = FVector2D::DotProduct(FVector2D(_graph.PositionX[_node], _graph.PositionY[_node]) - _start, _direction);
+		for (int s = 0; s < _maxSteps; ++s)
+		{
+			int _best = INDEX_NONE;
+			float _bestDistance = _corridor;
+			float _bestProgress = 0;
+			int _blockedNext = INDEX_NONE;
+			for (int e = _graph.NeighborBegin(_node); e < _graph.NeighborEnd(_node); ++e)
+			{
+				const int _next = _graph.Neighbors[e];
+				const FVector2D _offset = FVector2D(_graph.PositionX[_next], _graph.PositionY[_next]) - _start;
+				const float _along = FVector2D::DotProduct(_offset, _direction);
+				const float _distance = FMath::Abs(FVector2D::CrossProduct(_direction, _offset));
+				if (_next == _endNode && !(_blocked && _blocked->IsBlocked(_next)))
+				{
+					_outHit.LastNode = _next;
+					return true;
+				}
+				if (_along <= _progress + UE_KINDA_SMALL_NUMBER || _along > _length || _distance > _corridor) continue;		//	Must move toward the end, along the segment
+				if (_blocked && _blocked->IsBlocked(_next))
+				{
+					_blockedNext = _next;
+					continue;
+				}
+				if (_distance > _bestDistance || (_distance == _bestDistance && _along <= _bestProgress)) continue;
+
+				_best = _next;
+				_bestDistance = _distance;
+				_bestProgress = _along;
+			}
+			if (_best == INDEX_NONE)
+			{
+				_outHit.LastNode = _node;
+				_outHit.HitNode = _blockedNext;
+				_outHit.Fraction = FMath::Clamp(_progress / _length, 0.0f, 1.0f);
+				if (_blockedNext == INDEX_NONE)		//	Inaccessible or unlinked Node ahead (not a neighbor, found by location)
+				{
+					const FVector2D _ahead = _start + _direction * FMath::Min(_progress + _gap, _length);
+					const int _aheadNode = _graph.SpatialIndex.FindClosestNode(_graph, FVector(_ahead, _graph.PositionZ[_node]), _gap * 0.5f);
+					_outHit.HitNode = _aheadNode != _node ? _aheadNode : INDEX_NONE;
+				}
+				return false;
+			}
+			_node = _best;
+			_progress = _bestProgress;
+		}
+		_outHit.LastNode = _node;
+		_outHit.Fraction = FMath::Clamp(_progress / _length, 0.0f, 1.0f);
+		return false;
+	}
+}
+
+bool FNavigationRaycast::Raycast(const FNavigationGraph& _graph, const FVector& _start, const FVector& _end, const FNavigationBlockedNodes* _blocked, FNavigationRaycastHit& _outHit)
+{
+	using namespace NavigationRaycast;
+	_outHit = FNavigationRaycastHit();
+
+	bool _reached = false;
+	if (IsGridIndexed(_graph))
+		_reached = TraverseGrid(_graph, FVector2D(_start), FVector2D(_end), _blocked, false, _outHit);
+	else
+	{
+		const float _range = GetGap(_graph);
+		const int _startNode = _graph.SpatialIndex.FindClosestNode(_graph, _start, _range);
+		const int _endNode = _graph.SpatialIndex.FindClosestNode(_graph, _end, _range);
+		if (!IsOpen(_graph, _startNode, _blocked))
+		{
+			_outHit.HitNode = _startNode;
+			_outHit.Fraction = 0;
+		}
+		else if (_endNode == INDEX_NONE)			//	Off the mesh : walk until the border
+			WalkNeighbors(_graph, _startNode, INDEX_NONE, FVector2D(_start), FVector2D(_end), _blocked, _outHit);
+		else
+			_reached = WalkNeighbors(_graph, _startNode, _endNode, FVector2D(_start), FVector2D(_end), _blocked, _outHit);
+	}
+
+	_outHit.IsHit = !_reached;
+	if (_reached)
+		_outHit.Fraction = 1;
+	_outHit.Location = FMath::Lerp(_start, _end, _outHit.Fraction);
+	return _reached;
+}
+
+bool FNavigationRaycast::IsWalkable(const FNavigationGraph& _graph, const int _fromNode, const int _toNode, const FNavigationBlockedNodes* _blocked)
+{
+	using namespace NavigationRaycast;
+	if (!_graph.IsValidNode(_fromNode) || !IsOpen(_graph, _toNode, _blocked)) return false;
+
+	FNavigationRaycastHit _hit;
+	const FVector2D _from(_graph.PositionX[_fromNode], _graph.PositionY[_fromNode]);
+	const FVector2D _to(_graph.PositionX[_toNode], _graph.PositionY[_toNode]);
+	if (IsGridIndexed(_graph))
+		return TraverseGrid(_graph, _from, _to, _blocked, true, _hit);
+	return WalkNeighbors(_graph, _fromNode, _toNode, _from, _to, _blocked, _hit);
+}
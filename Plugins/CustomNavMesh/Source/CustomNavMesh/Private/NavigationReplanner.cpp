@@ -0,0 +1,405 @@
+#include "NavigationReplanner.h"
+
+namespace
+{
+	struct FOpenEntryLess
+	{
+		template<typename T>
+		FORCEINLINE bool operator()(const T& _a, const T& _b) const { return _a.Key1 < _b.Key1 || (_a.Key1 == _b.Key1 && _a.Key2 < _b.Key2); }
+	};
+}
+
+#pragma region Replan
+ENavigationReplanResult FNavigationReplanner::Replan(const FNavigationGraphPtr& _graph, const int _startNode, const int _goalNode, TArray<int>& _outPath, const FNavigationBlockedNodesPtr& _blocked)
+{
+	_outPath.Reset();
+	Expansions = 0;
+	if (!_graph || !_graph->IsValidNode(_startNode) || !_graph->IsValidNode(_goalNode))
+	{
+		Reset();
+		return ENavigationReplanResult::Failed;
+	}
+
+	bool _graphChanged = false;
+	if (Graph != _graph)
+	{
+		_graphChanged = true;
+		if (States.IsEmpty() || !ApplyGraphChanges(_graph))
+		{
+			Reset();
+			Graph = _graph;
+		}
+	}
+	if (BlockedNodes != _blocked)			//	Snapshots are immutable : another one means Nodes were blocked or freed
+	{
+		if (!States.IsEmpty())
+		{
+			_graphChanged = true;
+			ApplyBlockedChanges(_blocked);
+		}
+		BlockedNodes = _blocked;
+	}
+
+	ENavigationReplanResult _result = ENavigationReplanResult::Repaired;
+	if (States.IsEmpty())
+	{
+		Initialize(_startNode, _goalNode);
+		_result = ENavigationReplanResult::Planned;
+	}
+	else
+	{
+		if (!_graphChanged && _goalNode == GoalNode)		//	Sub path of a shortest path is a shortest path
+		{
+			const int _index = LastPath.Find(_startNode);
+			if (_index != INDEX_NONE)
+			{
+				_outPath = TArray<int>(LastPath.GetData() + _index, LastPath.Num() - _index);
+				return ENavigationReplanResult::Reused;
+			}
+		}
+
+		if (_startNode != StartNode && !Reroot(_startNode))
+		{
+			Initialize(_startNode, _goalNode);
+			_result = ENavigationReplanResult::Planned;
+		}
+		else if (_goalNode != GoalNode)
+		{
+			KeyModifier += FVector::Dist(Graph->NodeLocation(GoalNode), Graph->NodeLocation(_goalNode));
+			GoalNode = _goalNode;
+		}
+	}
+
+	ComputeShortestPath();
+	if (!ExtractPath(_outPath))
+	{
+		LastPath.Reset();
+		return ENavigationReplanResult::Failed;
+	}
+	LastPath = _outPath;
+	return _result;
+}
+
+void FNavigationReplanner::Reset()
+{
+	Graph = nullptr;
+	BlockedNodes = nullptr;
+	StartNode = GoalNode = INDEX_NONE;
+	KeyModifier = 0;
+	NodeSlots.Reset();
+	States.Reset();
+	OpenList.Reset();
+	OpenCount = 0;
+	LastPath.Reset();
+}
+
+int FNavigationReplanner::GetSlot(const int _node)
+{
+	if (const int* _slot = NodeSlots.Find(_node))
+		return *_slot;
+
+	const int _slot = States.AddDefaulted();
+	States[_slot].Node = _node;
+	NodeSlots.Add(_node, _slot);
+	return _slot;
+}
+
+void FNavigationReplanner::Initialize(const int _startNode, const int _goalNode)
+{
+	const FNavigationGraphPtr _graph = Graph;
+	const FNavigationBlockedNodesPtr _blocked = BlockedNodes;		//	Obstacles of this plan, not of the previous one
+	Reset();
+	Graph = _graph;
+	BlockedNodes = _blocked;
+	StartNode = _startNode;
+	GoalNode = _goalNode;
+
+	const int _slot = GetSlot(_startNode);
+	States[_slot].Rhs = Graph->IsNodeAccessible(_startNode) ? 0 : UE_MAX_FLT;
+	Queue(_slot);
+}
+#pragma endregion
+
+#pragma region Repair
+bool FNavigationReplanner::ApplyGraphChanges(const FNavigationGraphPtr& _graph)
+{
+	const FNavigationGraphPtr _previous = Graph;
+	if (!_previous || !_graph->HasChangedNodes || _graph->Version != _previous->Version + 1 || _graph->NodeCount() != _previous->NodeCount())
+		return false;
+
+	//	Predecessors of a Node changed if one of its in going edges changed : update every successor of the changed Nodes, before and after
+	TSet<int> _affected = { };
+	for (const int _node : _graph->ChangedNodes)
+	{
+		_affected.Add(_node);
+		for (int e = _previous->NeighborBegin(_node); e < _previous->NeighborEnd(_node); ++e)
+			_affected.Add(_previous->Neighbors[e]);
+		for (int e = _graph->NeighborBegin(_node); e < _graph->NeighborEnd(_node); ++e)
+			_affected.Add(_graph->Neighbors[e]);
+	}
+
+	Graph = _graph;
+	if (!Graph->IsNodeAccessible(StartNode))
+		return false;
+	for (const int _node : _affected)
+		UpdateNode(_node);
+	return true;
+}
+
+void FNavigationReplanner::ApplyBlockedChanges(const FNavigationBlockedNodesPtr& _blocked)
+{
+	TBitArray<> _flipped;
+	if (BlockedNodes && _blocked)
+		_flipped = TBitArray<>::BitwiseXOR(BlockedNodes->Blocked, _blocked->Blocked, EBitwiseOperatorFlags::MaxSize);
+	else
+		_flipped = BlockedNodes ? BlockedNodes->Blocked : _blocked->Blocked;
+
+	//	Same as a graph change : a flipped Node and its successors can get another Rhs
+	TSet<int> _affected = { };
+	for (TConstSetBitIterator<> _it(_flipped); _it; ++_it)
+	{
+		const int _node = _it.GetIndex();
+		if (!Graph->IsValidNode(_node)) continue;
+		_affected.Add(_node);
+		for (int e = Graph->NeighborBegin(_node); e < Graph->NeighborEnd(_node); ++e)
+			_affected.Add(Graph->Neighbors[e]);
+	}
+
+	BlockedNodes = _blocked;
+	for (const int _node : _affected)
+		UpdateNode(_node);
+}
+
+bool FNavigationReplanner::Reroot(const int _startNode)
+{
+	const int* _rootSlot = NodeSlots.Find(_startNode);
+	if (!_rootSlot || States[*_rootSlot].G >= UE_MAX_FLT) return false;
+
+	//	Nodes whose parent chain goes through the new start keep a valid G (minus the cost of the new start), the others are dropped
+	const float _offset = States[*_rootSlot].G;
+	const int _max = States.Num();
+	TArray<int8> _inTree = { };						//	0 = unknown, 1 = under the new start, -1 = not, 2 = being checked
+	_inTree.SetNumZeroed(_max);
+	_inTree[*_rootSlot] = 1;
+	TArray<int> _chain = { };
+	for (int i = 0; i < _max; ++i)
+	{
+		_chain.Reset();
+		int _slot = i;
+		while (_slot != INDEX_NONE && _inTree[_slot] == 0)
+		{
+			_inTree[_slot] = 2;
+			_chain.Add(_slot);
+			const int* _parent = NodeSlots.Find(States[_slot].Parent);
+			_slot = _parent ? *_parent : INDEX_NONE;
+		}
+		const int8 _value = _slot != INDEX_NONE && _inTree[_slot] == 1 ? 1 : -1;		//	Loops (being checked) are dropped
+		for (const int _chainSlot : _chain)
+			_inTree[_chainSlot] = _value;
+	}
+
+	const TArray<FNodeState> _previous = MoveTemp(States);
+	NodeSlots.Reset();
+	States.Reset();
+	OpenList.Reset();
+	OpenCount = 0;
+	KeyModifier = 0;
+	StartNode = _startNode;
+	for (int i = 0; i < _max; ++i)
+	{
+		const FNodeState& _state = _previous[i];
+		if (_inTree[i] != 1 || _state.G >= UE_MAX_FLT || _state.G < _offset) continue;
+
+		FNodeState& _kept = States[GetSlot(_state.Node)];
+		_kept.G = _state.G - _offset;
+		_kept.Parent = _state.Parent;
+	}
+
+	//	Successors of the kept Nodes are the new frontier
+	const int _keptMax = States.Num();
+	for (int i = 0; i < _keptMax; ++i)
+	{
+		const int _node = States[i].Node;
+		for (int e = Graph->NeighborBegin(_node); e < Graph->NeighborEnd(_node); ++e)
+			GetSlot(Graph->Neighbors[e]);
+	}
+	const int _stateMax = States.Num();
+	for (int i = 0; i < _stateMax; ++i)
+		UpdateNode(States[i].Node);
+	return true;
+}
+#pragma endregion
+
+#pragma region Search
+void FNavigationReplanner::ComputeKey(const FNodeState& _state, float& _key1, float& _key2) const
+{
+	_key2 = FMath::Min(_state.G, _state.Rhs);
+	_key1 = _key2 >= UE_MAX_FLT ? UE_MAX_FLT : _key2 + Heuristic(_state.Node) + KeyModifier;
+}
+
+void FNavigationReplanner::UpdateNode(const int _node)
+{
+	const int* _existing = NodeSlots.Find(_node);
+	float _rhs = 0;
+	int _parent = INDEX_NONE;
+	if (_node != StartNode)
+	{
+		_rhs = UE_MAX_FLT;
+		if (Graph->IsNodeAccessible(_node) && !IsBlocked(_node))
+			for (int e = Graph->ReverseNeighborBegin(_node); e < Graph->ReverseNeighborEnd(_node); ++e)
+			{
+				const int _previous = Graph->ReverseNeighbors[e];
+				const float _g = NodeG(_previous);
+				if (_g >= UE_MAX_FLT) continue;
+				const float _cost = _g + Graph->EdgeCost(_previous, _node);
+				if (_cost >= _rhs) continue;
+				_rhs = _cost;
+				_parent = _previous;
+			}
+		if (!_existing && _rhs >= UE_MAX_FLT) return;		//	Never reached, nothing to store
+	}
+
+	const int _slot = _existing ? *_existing : GetSlot(_node);
+	FNodeState& _state = States[_slot];
+	_state.Rhs = _rhs;
+	_state.Parent = _parent;
+	Unqueue(_slot);
+	if (_state.G != _state.Rhs)
+		Queue(_slot);
+}
+
+void FNavigationReplanner::Queue(const int _slot)
+{
+	FNodeState& _state = States[_slot];
+	if (!_state.Open)
+		OpenCount++;
+	_state.Open = true;
+	ComputeKey(_state, _state.Key1, _state.Key2);
+
+	FOpenEntry _entry;
+	_entry.Key1 = _state.Key1;
+	_entry.Key2 = _state.Key2;
+	_entry.Slot = _slot;
+	OpenList.HeapPush(_entry, FOpenEntryLess());
+}
+
+void FNavigationReplanner::Unqueue(const int _slot)
+{
+	FNodeState& _state = States[_slot];
+	if (!_state.Open) return;
+
+	_state.Open = false;		//	Its entries become stale
+	OpenCount--;
+}
+
+void FNavigationReplanner::CleanOpenListTop()
+{
+	while (!OpenList.IsEmpty())
+	{
+		const FOpenEntry& _top = OpenList.HeapTop();
+		const FNodeState& _state = States[_top.Slot];
+		if (_state.Open && _state.Key1 == _top.Key1 && _state.Key2 == _top.Key2) return;
+
+		FOpenEntry _stale;
+		OpenList.HeapPop(_stale, FOpenEntryLess(), false);
+	}
+
+	if (OpenList.Num() > 4 * OpenCount + 64)		//	Too many stale entries : rebuild the heap with the live ones
+	{
+		OpenList.RemoveAll([this](const FOpenEntry& _entry)
+		{
+			const FNodeState& _state = States[_entry.Slot];
+			return !_state.Open || _state.Key1 != _entry.Key1 || _state.Key2 != _entry.Key2;
+		});
+		OpenList.Heapify(FOpenEntryLess());
+	}
+}
+
+void FNavigationReplanner::ComputeShortestPath()
+{
+	const int _goalSlot = GetSlot(GoalNode);
+	while (true)
+	{
+		CleanOpenListTop();
+		if (OpenList.IsEmpty()) return;
+
+		float _goalKey1, _goalKey2;
+		const FNodeState& _goal = States[_goalSlot];
+		ComputeKey(_goal, _goalKey1, _goalKey2);
+		const FOpenEntry _top = OpenList.HeapTop();
+		if (!KeyLess(_top.Key1, _top.Key2, _goalKey1, _goalKey2) && _goal.G == _goal.Rhs) return;
+
+		FOpenEntry _popped;
+		OpenList.HeapPop(_popped, FOpenEntryLess(), false);
+		const int _slot = _top.Slot;
+		float _key1, _key2;
+		ComputeKey(States[_slot], _key1, _key2);
+		if (KeyLess(_top.Key1, _top.Key2, _key1, _key2))		//	Key was a lower bound (goal moved) : queue with the real one
+		{
+			States[_slot].Open = false;
+			OpenCount--;
+			Queue(_slot);
+			continue;
+		}
+
+		Unqueue(_slot);
+		Expansions++;
+		const int _node = States[_slot].Node;
+		if (States[_slot].G > States[_slot].Rhs)				//	Over consistent : settle, successors can only get cheaper
+		{
+			States[_slot].G = States[_slot].Rhs;
+			const float _g = States[_slot].G;
+			for (int e = Graph->NeighborBegin(_node); e < Graph->NeighborEnd(_node); ++e)
+			{
+				const int _next = Graph->Neighbors[e];
+				if (_next == StartNode || IsBlocked(_next)) continue;		//	Same as UpdateNode : a blocked Node never gets a Rhs
+
+				const int _nextSlot = GetSlot(_next);
+				FNodeState& _nextState = States[_nextSlot];
+				const float _nextRhs = _g + Graph->EdgeCost(_node, _next);
+				if (_nextRhs >= _nextState.Rhs) continue;
+
+				_nextState.Rhs = _nextRhs;
+				_nextState.Parent = _node;
+				Unqueue(_nextSlot);
+				if (_nextState.G != _nextState.Rhs)
+					Queue(_nextSlot);
+			}
+		}
+		else													//	Under consistent : invalidate, successors using it look for another parent
+		{
+			States[_slot].G = UE_MAX_FLT;
+			UpdateNode(_node);
+			for (int e = Graph->NeighborBegin(_node); e < Graph->NeighborEnd(_node); ++e)
+			{
+				const int* _nextSlot = NodeSlots.Find(Graph->Neighbors[e]);
+				if (_nextSlot && States[*_nextSlot].Parent == _node)
+					UpdateNode(Graph->Neighbors[e]);
+			}
+		}
+	}
+}
+
+bool FNavigationReplanner::ExtractPath(TArray<int>& _outPath) const
+{
+	_outPath.Reset();
+	const int* _goalSlot = NodeSlots.Find(GoalNode);
+	if (!_goalSlot || States[*_goalSlot].G >= UE_MAX_FLT) return false;
+
+	const int _max = States.Num();
+	for (int _node = GoalNode; _node != StartNode; )
+	{
+		_outPath.Add(_node);
+		const int* _slot = NodeSlots.Find(_node);
+		if (!_slot || _outPath.Num() > _max)			//	Broken parent chain, never happens on a consistent tree
+		{
+			_outPath.Reset();
+			return false;
+		}
+		_node = States[*_slot].Parent;
+	}
+	_outPath.Add(StartNode);
+	Algo::Reverse(_outPath);
+	return true;
+}
+#pragma endregion
@@ -0,0 +1,380 @@
+#include "NavigationSearch.h"
+
+#pragma region Heap
+void FNavigationNodeHeap::Reset(const int _nodeCount)
+{
+	const int _max = Heap.Num();
+	for (int i = 0; i < _max; ++i)
+		HeapIndex[Heap[i]] = INDEX_NONE;		//	Popped nodes are already INDEX_NONE, only clear what is still queued
+	Heap.Reset();
+	Keys.Reset();
+
+	if (HeapIndex.Num() != _nodeCount)
+	{
+		HeapIndex.SetNumUninitialized(_nodeCount);
+		for (int i = 0; i < _nodeCount; ++i)
+			HeapIndex[i] = INDEX_NONE;
+	}
+}
+
+void FNavigationNodeHeap::Push(const int _node, const float _key)
+{
+	int& _slot = HeapIndex[_node];
+	if (_slot != INDEX_NONE)					//	Already queued : Decrease Key
+	{
+		if (_key >= Keys[_slot]) return;
+		Keys[_slot] = _key;
+		SiftUp(_slot);
+		return;
+	}
+
+	_slot = Heap.Add(_node);
+	Keys.Add(_key);
+	SiftUp(_slot);
+}
+
+int FNavigationNodeHeap::Pop()
+{
+	const int _node = Heap[0];
+	const int _last = Heap.Num() - 1;
+	Swap(0, _last);
+	Heap.RemoveAt(_last, 1, false);
+	Keys.RemoveAt(_last, 1, false);
+	HeapIndex[_node] = INDEX_NONE;
+
+	if (!Heap.IsEmpty())
+		SiftDown(0);
+	return _node;
+}
+
+void FNavigationNodeHeap::Remove(const int _node)
+{
+	if (!Contains(_node)) return;
+
+	const int _slot = HeapIndex[_node];
+	const int _last = Heap.Num() - 1;
+	Swap(_slot, _last);
+	Heap.RemoveAt(_last, 1, false);
+	Keys.RemoveAt(_last, 1, false);
+	HeapIndex[_node] = INDEX_NONE;
+
+	if (_slot < Heap.Num())
+	{
+		SiftUp(_slot);
+		SiftDown(HeapIndex[Heap[_slot]]);
+	}
+}
+
+void FNavigationNodeHeap::SiftUp(int _slot)
+{
+	while (_slot > 0)
+	{
+		const int _parent = (_slot - 1) / 2;
+		if (Keys[_parent] <= Keys[_slot]) return;
+		Swap(_slot, _parent);
+		_slot = _parent;
+	}
+}
+
+void FNavigationNodeHeap::SiftDown(int _slot)
+{
+	const int _max = Heap.Num();
+	while (true)
+	{
+		const int _left = _slot * 2 + 1;
+		const int _right = _left + 1;
+		int _smallest = _slot;
+
+		if (_left < _max && Keys[_left] < Keys[_smallest])
+			_smallest = _left;
+		if (_right < _max && Keys[_right] < Keys[_smallest])
+			_smallest = _right;
+		if (_smallest == _slot) return;
+
+		Swap(_slot, _smallest);
+		_slot = _smallest;
+	}
+}
+
+void FNavigationNodeHeap::Swap(const int _slotA, const int _slotB)
+{
+	if (_slotA == _slotB) return;
+
+	Heap.Swap(_slotA, _slotB);
+	Keys.Swap(_slotA, _slotB);
+	HeapIndex[Heap[_slotA]] = _slotA;
+	HeapIndex[Heap[_slotB]] = _slotB;
+}
+#pragma endregion
+
+#pragma region State
+void FNavigationSearchState::Reset(const int _nodeCount)
+{
+	if (Stamp.Num() != _nodeCount)
+	{
+		Cost.SetNumUninitialized(_nodeCount);
+		Parent.SetNumUninitialized(_nodeCount);
+		Closed.SetNumUninitialized(_nodeCount);
+		Stamp.SetNumZeroed(_nodeCount);
+		QueryStamp = 0;
+	}
+
+	QueryStamp++;
+	if (QueryStamp == 0)						//	Stamp wrapped around : old entries could look valid again
+	{
+		FMemory::Memzero(Stamp.GetData(), Stamp.Num() * sizeof(uint32));
+		QueryStamp = 1;
+	}
+}
+
+void FNavigationSearchState::Visit(const int _node)
+{
+	Stamp[_node] = QueryStamp;
+	Cost[_node] = UE_MAX_FLT;
+	Parent[_node] = INDEX_NONE;
+	Closed[_node] = false;
+}
+#pragma endregion
+
+#pragma region Search
+bool FNavigationSearch::FindPath(const FNavigationGraph& _graph, const int _startNode, const int _endNode, TArray<int>& _outPath, const std::atomic<bool>* _cancelled, const FNavigationBlockedNodes* _blocked)
+{
+	_outPath.Reset();
+	Begin(_graph, _startNode, _endNode, _blocked);
+	while (Status == ENavigationSearchStatus::InProgress)
+	{
+		if (_cancelled && _cancelled->load(std::memory_order_relaxed))
+			Abort();
+		else
+			Step(256);
+	}
+
+	if (Status != ENavigationSearchStatus::Succeeded)
+		return false;
+	GetPath(_outPath);
+	return true;
+}
+
+bool FNavigationSearch::FindPath(const FNavigationPathRequest& _request, TArray<int>& _outPath, const std::atomic<bool>* _cancelled)
+{
+	_outPath.Reset();
+	if (!_request.IsValid()) return false;
+
+	const FNavigationBlockedNodes* _blocked = _request.BlockedNodes.Get();
+	bool _found = false;
+	if (_request.Mode == ENavigationSearchMode::SearchHierarchical && _request.Hierarchy)
+		_found = _request.Hierarchy->FindPath(*_request.Graph, _request.StartNode, _request.EndNode, *this, _outPath);
+	else if (_request.Mode == ENavigationSearchMode::SearchJumpPoint && _request.JumpPointGrid)
+		_found = _request.JumpPointGrid->FindPath(*_request.Graph, _request.StartNode, _request.EndNode, *this, _outPath);
+	else if (_request.Mode == ENavigationSearchMode::SearchBidirectional)
+		return FindPathBidirectional(*_request.Graph, _request.StartNode, _request.EndNode, _outPath, _cancelled, _blocked);
+	else
+		return FindPath(*_request.Graph, _request.StartNode, _request.EndNode, _outPath, _cancelled, _blocked);
+
+	//	Clusters and jump grid ignore the obstacles : a path through a blocked Node is searched again with A*
+	if (!_blocked || !IsPathBlocked(_outPath, *_blocked)) return _found;
+	return FindPath(*_request.Graph, _request.StartNode, _request.EndNode, _outPath, _cancelled, _blocked);
+}
+
+bool FNavigationSearch::FindPathBidirectional(const FNavigationGraph& _graph, const int _startNode, const int _endNode, TArray<int>& _outPath, const std::atomic<bool>* _cancelled, const FNavigationBlockedNodes* _blocked)
+{
+	_outPath.Reset();
+	Abort();											//	Shares the search data of the stepped search
+	Expansions = 0;
+	if (!_graph.IsValidNode(_startNode) || !_graph.IsValidNode(_endNode) || (_blocked && _blocked->IsBlocked(_endNode))) return false;
+	if (_startNode == _endNode)
+	{
+		_outPath.Add(_startNode);
+		return true;
+	}
+
+	//	Forward potential, the backward one is its opposite : both stay consistent and the keys of the two searches can be added
+	const FVector _startLocation = _graph.NodeLocation(_startNode);
+	const FVector _endLocation = _graph.NodeLocation(_endNode);
+	auto _potential = [&](const int _node)
+	{
+		const FVector& _location = _graph.NodeLocation(_node);
+		return (FVector::Dist(_location, _endLocation) - FVector::Dist(_location, _startLocation)) * 0.5f;
+	};
+
+	const int _max = _graph.NodeCount();
+	State.Reset(_max);
+	OpenList.Reset(_max);
+	BackwardState.Reset(_max);
+	BackwardOpenList.Reset(_max);
+	State.Visit(_startNode);
+	State.Cost[_startNode] = 0;
+	OpenList.Push(_startNode, _potential(_startNode));
+	BackwardState.Visit(_endNode);
+	BackwardState.Cost[_endNode] = 0;
+	BackwardOpenList.Push(_endNode, -_potential(_endNode));
+
+	float _bestCost = UE_MAX_FLT;						//	Cheapest path found through a Node reached by both searches
+	int _meetingNode = INDEX_NONE;
+	while (!OpenList.IsEmpty() && !BackwardOpenList.IsEmpty())
+	{
+		if (OpenList.TopKey() + BackwardOpenList.TopKey() >= _bestCost) break;		//	No cheaper path can meet anymore
+		if (_cancelled && (Expansions & 255) == 255 && _cancelled->load(std::memory_order_relaxed)) return false;
+
+		const bool _isForward = OpenList.Num() <= BackwardOpenList.Num();		//	Expand the smallest frontier
+		FNavigationSearchState& _state = _isForward ? State : BackwardState;
+		const FNavigationSearchState& _otherState = _isForward ? BackwardState : State;
+		FNavigationNodeHeap& _openList = _isForward ? OpenList : BackwardOpenList;
+
+		const int _node = _openList.Pop();
+		_state.Closed[_node] = true;
+		Expansions++;
+
+		const float _cost = _state.Cost[_node];
+		const int _end = _isForward ? _graph.NeighborEnd(_node) : _graph.ReverseNeighborEnd(_node);
+		for (int e = _isForward ? _graph.NeighborBegin(_node) : _graph.ReverseNeighborBegin(_node); e < _end; ++e)
+		{
+			const int _next = _isForward ? _graph.Neighbors[e] : _graph.ReverseNeighbors[e];
+			if (_blocked && _next != _startNode && _blocked->IsBlocked(_next))	//	Start Node can be blocked, the Agent is leaving it
+				continue;
+			if (!_state.IsVisited(_next))
+				_state.Visit(_next);
+			else if (_state.Closed[_next])
+				continue;
+
+			const float _nextCost = _cost + _graph.EdgeCost(_node, _next);		//	Same cost both ways
+			if (_nextCost >= _state.Cost[_next]) continue;
+
+			_state.Cost[_next] = _nextCost;
+			_state.Parent[_next] = _node;
+			_openList.Push(_next, _nextCost + (_isForward ? _potential(_next) : -_potential(_next)));
+			if (_otherState.IsVisited(_next) && _nextCost + _otherState.Cost[_next] < _bestCost)
+			{
+				_bestCost = _nextCost + _otherState.Cost[_next];
+				_meetingNode = _next;
+			}
+		}
+	}
+	if (_meetingNode == INDEX_NONE) return false;
+
+	for (int _node = _meetingNode; _node != INDEX_NONE; _node = State.Parent[_node])			//	Start -> meeting Node
+		_outPath.Add(_node);
+	Algo::Reverse(_outPath);
+	for (int _node = BackwardState.Parent[_meetingNode]; _node != INDEX_NONE; _node = BackwardState.Parent[_node])	//	Meeting Node -> End
+		_outPath.Add(_node);
+	return true;
+}
+
+bool FNavigationSearch::IsPathBlocked(const TArray<int>& _path, const FNavigationBlockedNodes& _blocked)
+{
+	for (int i = 1; i < _path.Num(); ++i)		//	Start Node can be blocked, the Agent is leaving it
+		if (_blocked.IsBlocked(_path[i]))
+			return true;
+	return false;
+}
+
+ENavigationSearchStatus FNavigationSearch::Begin(const FNavigationGraph& _graph, const int _startNode, const int _endNode, const FNavigationBlockedNodes* _blocked)
+{
+	Graph = &_graph;
+	BlockedNodes = _blocked;
+	StartNode = _startNode;
+	EndNode = _endNode;
+	Expansions = 0;
+	if (!_graph.IsValidNode(_startNode) || !_graph.IsValidNode(_endNode))
+	{
+		Abort();
+		return Status;
+	}
+
+	EndLocation = _graph.NodeLocation(_endNode);		//	Edge costs are >= the distance : admissible and consistent estimate
+	Landmarks = _graph.Landmarks.IsBuilt() ? &_graph.Landmarks : nullptr;
+	if (Landmarks)
+		Landmarks->TargetRows(_endNode, EndLandmarkFrom, EndLandmarkTo);
+
+	State.Reset(_graph.NodeCount());					//	Per query data lives in flat arrays indexed by Node index (no Node map)
+	OpenList.Reset(_graph.NodeCount());					//	Nodes to check, ordered by Cost + estimate
+	State.Visit(_startNode);
+	State.Cost[_startNode] = 0;
+	OpenList.Push(_startNode, EstimateCost(_startNode));	//	Set first node to check with StartNode
+	
+	Status = ENavigationSearchStatus::InProgress;
+	return Status;
+}
+
+ENavigationSearchStatus FNavigationSearch::Step(const int _maxExpansions, const double _maxSeconds)
+{
+	if (Status != ENavigationSearchStatus::InProgress) return Status;
+
+	const FNavigationGraph& _graph = *Graph;
+	const FNavigationBlockedNodes* _blocked = BlockedNodes;
+	const double _endTime = _maxSeconds > 0 ? FPlatformTime::Seconds() + _maxSeconds : 0;
+	for (int _step = 0; _step < _maxExpansions; ++_step)
+	{
+		if (OpenList.IsEmpty())							//	Open List have been fully checked and no path have been found to End Node
+		{
+			Status = ENavigationSearchStatus::Failed;
+			return Status;
+		}
+		if (_endTime > 0 && (_step & 31) == 31 && FPlatformTime::Seconds() >= _endTime)
+			return Status;								//	Out of time, continue on next Step
+
+		const int _node = OpenList.Pop();				//	Pop the cheapest element of Open list
+		State.Closed[_node] = true;						//	Close the popped Node (whatever happen, node is now checked)
+		Expansions++;
+
+		if (_node == EndNode)							//	If the popped Node is the End Node, Path have been completed
+		{
+			Status = ENavigationSearchStatus::Succeeded;
+			return Status;
+		}
+
+		const float _cost = State.Cost[_node];
+		const int _end = _graph.NeighborEnd(_node);
+		for (int e = _graph.NeighborBegin(_node); e < _end; ++e)	// Pass through node Neighbors (only accessible Nodes are linked in the graph)
+		{
+			const int _next = _graph.Neighbors[e];
+			if (_blocked && _blocked->IsBlocked(_next))	//	Blocked by a runtime obstacle
+				continue;
+			if (!State.IsVisited(_next))
+				State.Visit(_next);
+
+			const float _nextCost = _cost + _graph.EdgeCost(_node, _next);	//	New Cost of the Neighbor (Current Node Cost + Edge Cost)
+			if (_nextCost < State.Cost[_next])			//	If Neighbor have not been reached yet OR New Cost of the Neighbor is less than the actual Neighbor Cost
+			{
+				State.Cost[_next] = _nextCost;
+				State.Parent[_next] = _node;
+				State.Closed[_next] = false;			//	Reopened if already checked : quantized landmark bounds are admissible, not always consistent
+				OpenList.Push(_next, _nextCost + EstimateCost(_next));	//	Add or Decrease Key
+			}
+		}
+	}
+
+	if (OpenList.IsEmpty())
+		Status = ENavigationSearchStatus::Failed;
+	return Status;
+}
+
+void FNavigationSearch::Abort()
+{
+	Status = ENavigationSearchStatus::Failed;
+	Graph = nullptr;
+	BlockedNodes = nullptr;
+	Landmarks = nullptr;
+}
+
+void FNavigationSearch::GetPath(TArray<int>& _outPath) const
+{
+	_outPath.Reset();
+	if (Status != ENavigationSearchStatus::Succeeded) return;
+
+	int _currentNode = EndNode;
+	while (_currentNode != StartNode)
+	{
+		if (_currentNode == INDEX_NONE || !State.IsVisited(_currentNode))
+		{
+			_outPath.Reset();
+			return;
+		}
+
+		_outPath.Add(_currentNode);
+		_currentNode = State.Parent[_currentNode];
+	}
+	_outPath.Add(StartNode);
+	Algo::Reverse(_outPath);
+}
+#pragma endregion
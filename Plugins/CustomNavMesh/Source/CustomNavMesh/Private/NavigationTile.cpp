@@ -0,0 +1,104 @@
+#include "NavigationTile.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Serialization/Archive.h"
+
+namespace NavigationTile
+{
+	constexpr uint32 FileMagic = 0x4C54564E;		//	"NVTL"
+	constexpr uint32 FileVersion = 1;
+
+	//	CSR offsets start at 0, never decrease and end on the element count (same checks as the baked graph)
+	bool AreOffsetsValid(const TArray<int>& _offsets, const int _count, const int _elementCount)
+	{
+		if (_offsets.Num() != _count + 1 || _offsets[0] != 0 || _offsets[_count] != _elementCount) return false;
+		for (int i = 1; i <= _count; ++i)
+			if (_offsets[i] < _offsets[i - 1]) return false;
+		return true;
+	}
+}
+
+#pragma region Tile Data
+void FNavigationTileData::MoveFromGenerator(FNavigationMeshGenerator& _generator)
+{
+	Layout = _generator.GenerationLayout();
+	_generator.MoveResults(Samples, NeighborOffsets, Neighbors);
+}
+
+bool FNavigationTileData::Serialize(FArchive& _archive)
+{
+	uint32 _magic = NavigationTile::FileMagic;
+	uint32 _version = NavigationTile::FileVersion;
+	_archive << _magic << _version;
+	if (_magic != NavigationTile::FileMagic || _version != NavigationTile::FileVersion) return false;
+
+	_archive << Coord;
+	_archive << Layout.Origin << Layout.Gap << Layout.SizeX << Layout.SizeY << Layout.IsSimpleGrid;
+
+	int _count = Samples.Num();
+	_archive << _count;
+	if (_archive.IsLoading())
+	{
+		if (_count < 0) return false;
+		Samples.SetNum(_count);
+	}
+	for (FNavigationGenerationSample& _sample : Samples)
+		_archive << _sample.Location << _sample.IsAccessible;
+
+	_archive << NeighborOffsets << Neighbors;
+	if (_archive.IsError()) return false;
+
+	//	Reject corrupted files before their indices are used
+	if (!NavigationTile::AreOffsetsValid(NeighborOffsets, _count, Neighbors.Num())) return false;
+	for (const int _neighbor : Neighbors)
+		if (_neighbor < 0 || _neighbor >= _count) return false;
+	return true;
+}
+
+bool FNavigationTileData::SaveToFile(const FString& _path)
+{
+	const TUniquePtr<FArchive> _writer = TUniquePtr<FArchive>(IFileManager::Get().CreateFileWriter(*_path));
+	if (!_writer) return false;
+
+	Serialize(*_writer);
+	return _writer->Close();
+}
+
+bool FNavigationTileData::LoadFromFile(const FString& _path)
+{
+	const TUniquePtr<FArchive> _reader = TUniquePtr<FArchive>(IFileManager::Get().CreateFileReader(*_path));
+	if (!_reader) return false;
+
+	const bool _success = Serialize(*_reader);
+	return _reader->Close() && _success;
+}
+
+FString FNavigationTileData::GetFilePath(const FString& _root, const FString& _meshName, const FIntPoint& _coord)
+{
+	return FPaths::Combine(_root, TEXT("NavigationTiles"), _meshName, FString::Printf(TEXT("%d_%d.navtile"), _coord.X, _coord.Y));
+}
+#pragma endregion
+
+#pragma region Tile Grid
+FNavigationGridLayout FNavigationTileGrid::TileLayout(const FIntPoint& _coord, const bool _isSimpleGrid) const
+{
+	const int _firstX = _coord.X * TileSize;
+	const int _firstY = _coord.Y * TileSize;
+	const int _sizeX = FMath::Min(TileSize, SizeX - _firstX);
+	const int _sizeY = FMath::Min(TileSize, SizeY - _firstY);
+	return FNavigationGridLayout(Origin + FVector(_firstX * Gap, _firstY * Gap, 0), Gap, _sizeX, _sizeY, _isSimpleGrid);
+}
+
+FBox2D FNavigationTileGrid::TileBounds(const FIntPoint& _coord) const
+{
+	const FNavigationGridLayout& _layout = TileLayout(_coord, true);
+	const FVector2D _min = FVector2D(_layout.Origin.X, _layout.Origin.Y);
+	return FBox2D(_min, _min + FVector2D(_layout.SizeX - 1, _layout.SizeY - 1) * Gap);
+}
+
+float FNavigationTileGrid::TileDistance(const FIntPoint& _coord, const FVector& _worldLocation) const
+{
+	return FMath::Sqrt(TileBounds(_coord).ComputeSquaredDistanceToPoint(FVector2D(_worldLocation.X, _worldLocation.Y)));
+}
+#pragma endregion
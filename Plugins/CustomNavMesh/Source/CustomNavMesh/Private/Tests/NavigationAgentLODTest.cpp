@@ -0,0 +1,52 @@
+#include "Misc/AutomationTest.h"
+
+#include "NavigationAgentComponent.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNavigationAgentLODTest, "CustomNavMesh.Agent.LODBuckets", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FNavigationAgentLODTest::RunTest(const FString& Parameters)
+{
+	//	Borders at 2000 and 6000 (significance 0.66 and 0.33), last bucket is everything past them
+	const TArray<FNavigationAgentLODLevel> _levels = {
+		FNavigationAgentLODLevel(2000, 0.66f, 0, 0.5f, 1),
+		FNavigationAgentLODLevel(6000, 0.33f, 0.1f, 1.5f, 2),
+		FNavigationAgentLODLevel(0, 0, 0.25f, 4, 4)
+	};
+	const float _hysteresis = 300;
+
+	//	Distance : from the coarsest bucket to the finest
+	int _lod = UNavigationAgentComponent::SelectLODLevel(_levels, 2, 10000, _hysteresis, false);
+	TestEqual(TEXT("Far Agent stays in the coarsest bucket"), _lod, 2);
+	_lod = UNavigationAgentComponent::SelectLODLevel(_levels, _lod, 5800, _hysteresis, false);
+	TestEqual(TEXT("Within the hysteresis of the middle bucket : coarsest bucket kept"), _lod, 2);
+	_lod = UNavigationAgentComponent::SelectLODLevel(_levels, _lod, 1900, _hysteresis, false);
+	TestEqual(TEXT("Past the middle border but within the hysteresis of the finest : middle bucket"), _lod, 1);
+	_lod = UNavigationAgentComponent::SelectLODLevel(_levels, _lod, 1900, _hysteresis, false);
+	TestEqual(TEXT("Within the hysteresis of the finest bucket : middle bucket kept"), _lod, 1);
+	_lod = UNavigationAgentComponent::SelectLODLevel(_levels, _lod, 1600, _hysteresis, false);
+	TestEqual(TEXT("Past the hysteresis of the finest bucket : finest bucket"), _lod, 0);
+	TestEqual(TEXT("Coarsest to finest in one update"), UNavigationAgentComponent::SelectLODLevel(_levels, 2, 100, _hysteresis, false), 0);
+
+	//	Distance : back to the coarser buckets
+	_lod = UNavigationAgentComponent::SelectLODLevel(_levels, 0, 2200, _hysteresis, false);
+	TestEqual(TEXT("Within the hysteresis of the finest border : finest bucket kept"), _lod, 0);
+	_lod = UNavigationAgentComponent::SelectLODLevel(_levels, _lod, 2400, _hysteresis, false);
+	TestEqual(TEXT("Past the hysteresis of the finest border : middle bucket"), _lod, 1);
+	_lod = UNavigationAgentComponent::SelectLODLevel(_levels, _lod, 7000, _hysteresis, false);
+	TestEqual(TEXT("Past the hysteresis of the middle border : coarsest bucket"), _lod, 2);
+
+	//	Significance : from the coarsest bucket to the finest
+	const float _significanceHysteresis = 0.05f;
+	_lod = UNavigationAgentComponent::SelectLODLevel(_levels, 2, 0.35f, _significanceHysteresis, true);
+	TestEqual(TEXT("Significance within the hysteresis of the middle bucket : coarsest bucket kept"), _lod, 2);
+	_lod = UNavigationAgentComponent::SelectLODLevel(_levels, _lod, 0.68f, _significanceHysteresis, true);
+	TestEqual(TEXT("Significance past the middle border only : middle bucket"), _lod, 1);
+	_lod = UNavigationAgentComponent::SelectLODLevel(_levels, _lod, 0.9f, _significanceHysteresis, true);
+	TestEqual(TEXT("High significance : finest bucket"), _lod, 0);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,60 @@
+#include "Misc/AutomationTest.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+#include "NavigationMesh.h"
+#include "NavigationNode.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNavigationMeshDirtyPatchTest, "CustomNavMesh.Mesh.DirtyPatchRaisedColumn", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FNavigationMeshDirtyPatchTest::RunTest(const FString& Parameters)
+{
+	UWorld* _world = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& _context = GEngine->CreateNewWorldContext(EWorldType::Game);
+	_context.SetCurrentWorld(_world);
+	ANavigationMesh* _mesh = _world->SpawnActor<ANavigationMesh>();
+
+	//	Complex 3x3 grid of one floor, 8 neighbors in walk range (diagonal 141 < 150)
+	const int _size = 3;
+	const float _gap = 100;
+	_mesh->NavMeshSettings.NavigationGridGap = _gap;
+	_mesh->NavMeshSettings.AgentExtraWalkStep = 50;
+	_mesh->GridLayout = FNavigationGridLayout(FVector::ZeroVector, _gap, _size, _size, false);
+	for (int x = 0; x < _size; ++x)
+		for (int y = 0; y < _size; ++y)
+		{
+			UNavigationNode* _node = NewObject<UNavigationNode>(_mesh);
+			_node->InitializeNavigationNode(FVector(x * _gap, y * _gap, 0), true);
+			_node->SetNodeIndex(_mesh->NavigationNodes.Add(_node));
+		}
+	for (UNavigationNode* _node : _mesh->NavigationNodes)
+		for (UNavigationNode* _other : _mesh->NavigationNodes)
+			if (_other != _node && FVector::Dist(_node->NodeLocation(), _other->NodeLocation()) <= 150)
+				_node->AddNeighbor(_other);
+
+	UNavigationNode* _center = _mesh->NavigationNodes[1 * _size + 1];
+	TestEqual(TEXT("Center Node linked to the 8 Nodes around it"), _center->NodeNeighbors().Num(), 8);
+
+	//	Ground of the center column raised past the walk range : the same Node object is moved up
+	const TArray<FNavigationGenerationSample> _samples = { FNavigationGenerationSample(FVector(_gap, _gap, 500), true) };
+	_mesh->PatchDirtyRegionComplex(FIntPoint(1, 1), FNavigationGridLayout(FVector(_gap, _gap, 0), _gap, 1, 1, false), _samples);
+
+	TestEqual(TEXT("Center Node kept"), _mesh->NavigationNodes[1 * _size + 1], _center);
+	TestEqual(TEXT("Center Node moved up"), _center->NodeLocation().Z, 500.0);
+	TestEqual(TEXT("Raised Node has no edge left"), _center->NodeNeighbors().Num(), 0);
+	for (const UNavigationNode* _node : _mesh->NavigationNodes)
+	{
+		if (_node == _center) continue;
+		TestFalse(FString::Printf(TEXT("Node %d has no edge to the raised Node"), _node->NodeIndex()), _node->NeighborExist(_center));
+		TestTrue(FString::Printf(TEXT("Node %d keeps edges on its floor"), _node->NodeIndex()), _node->NodeNeighbors().Num() >= 2);
+	}
+
+	GEngine->DestroyWorldContext(_world);
+	_world->DestroyWorld(false);
+	return true;
+}
+
+#endif
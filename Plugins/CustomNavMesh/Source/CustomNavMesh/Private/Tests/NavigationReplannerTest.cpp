@@ -0,0 +1,75 @@
+#include "Misc/AutomationTest.h"
+
+#include "NavigationGraph.h"
+#include "NavigationNode.h"
+#include "NavigationReplanner.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNavigationReplannerObstacleTest, "CustomNavMesh.Replanner.ObstacleOnPath", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FNavigationReplannerObstacleTest::RunTest(const FString& Parameters)
+{
+	//	Simple 5x5 grid, 4 neighbors per Node, Node index = X * SizeY + Y
+	const int _size = 5;
+	const float _gap = 100;
+	TArray<UNavigationNode*> _nodes = { };
+	for (int x = 0; x < _size; ++x)
+		for (int y = 0; y < _size; ++y)
+		{
+			UNavigationNode* _node = NewObject<UNavigationNode>(GetTransientPackage());
+			_node->InitializeNavigationNode(FVector(x * _gap, y * _gap, 0), true);
+			_node->SetNodeIndex(_nodes.Num());
+			_nodes.Add(_node);
+		}
+	for (int x = 0; x < _size; ++x)
+		for (int y = 0; y < _size; ++y)
+		{
+			UNavigationNode* _node = _nodes[x * _size + y];
+			if (x > 0) _node->AddNeighbor(_nodes[(x - 1) * _size + y]);
+			if (x < _size - 1) _node->AddNeighbor(_nodes[(x + 1) * _size + y]);
+			if (y > 0) _node->AddNeighbor(_nodes[x * _size + y - 1]);
+			if (y < _size - 1) _node->AddNeighbor(_nodes[x * _size + y + 1]);
+		}
+	const FNavigationGraphPtr _graph = FNavigationGraph::Compile(_nodes, FNavigationGridLayout(FVector::ZeroVector, _gap, _size, _size, true));
+
+	//	Straight line along X in the middle row
+	const int _start = 0 * _size + 2;
+	const int _goal = 4 * _size + 2;
+	FNavigationReplanner _replanner;
+	TArray<int> _path = { };
+	_replanner.Replan(_graph, _start, _goal, _path);
+	TestEqual(TEXT("Initial path length"), _path.Num(), _size);
+	const int _onPath = 2 * _size + 2;
+	TestTrue(TEXT("Initial path goes through the middle Node"), _path.Contains(_onPath));
+
+	//	Agent moved one Node forward and an obstacle moved onto the next Node of its path
+	TSharedRef<FNavigationBlockedNodes, ESPMode::ThreadSafe> _blocked = MakeShared<FNavigationBlockedNodes, ESPMode::ThreadSafe>();
+	_blocked->Blocked.Init(false, _graph->NodeCount());
+	_blocked->Blocked[_onPath] = true;
+	_blocked->Version = 1;
+	const int _moved = _path[1];
+	const ENavigationReplanResult _result = _replanner.Replan(_graph, _moved, _goal, _path, _blocked);
+	TestNotEqual(TEXT("Replan found a path"), _result, ENavigationReplanResult::Failed);
+	TestTrue(TEXT("Replanned path goes from the new start to the goal"), _path.Num() > 1 && _path[0] == _moved && _path.Last() == _goal);
+	TestFalse(TEXT("Replanned path avoids the obstacle"), _path.Contains(_onPath));
+
+	//	Obstacle moves again onto the replanned path : the previously blocked Node is freed
+	const int _nextOnPath = _path[_path.Num() / 2];
+	TSharedRef<FNavigationBlockedNodes, ESPMode::ThreadSafe> _movedBlocked = MakeShared<FNavigationBlockedNodes, ESPMode::ThreadSafe>();
+	_movedBlocked->Blocked.Init(false, _graph->NodeCount());
+	_movedBlocked->Blocked[_nextOnPath] = true;
+	_movedBlocked->Version = 2;
+	_replanner.Replan(_graph, _moved, _goal, _path, _movedBlocked);
+	TestTrue(TEXT("Path after the second move reaches the goal"), _path.Num() > 1 && _path.Last() == _goal);
+	TestFalse(TEXT("Path after the second move avoids the obstacle"), _path.Contains(_nextOnPath));
+
+	//	A plan started from scratch keeps the obstacles of the request
+	_replanner.Reset();
+	_replanner.Replan(_graph, _start, _goal, _path, _blocked);
+	TestFalse(TEXT("Plan from scratch avoids the obstacle"), _path.Contains(_onPath));
+
+	return true;
+}
+
+#endif
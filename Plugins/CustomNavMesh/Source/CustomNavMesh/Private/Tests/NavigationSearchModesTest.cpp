@@ -0,0 +1,85 @@
+#include "Misc/AutomationTest.h"
+
+#include "NavigationGraph.h"
+#include "NavigationNode.h"
+#include "NavigationSearch.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNavigationSearchModesTest, "CustomNavMesh.Search.BidirectionalMatchesAStar", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FNavigationSearchModesTest::RunTest(const FString& Parameters)
+{
+	//	6x6 grid, 8 neighbors, uneven heights, a wall on X = 3 with a gap at Y = 0, Node index = X * SizeY + Y
+	const int _size = 6;
+	const float _gap = 100;
+	TArray<UNavigationNode*> _nodes = { };
+	for (int x = 0; x < _size; ++x)
+		for (int y = 0; y < _size; ++y)
+		{
+			UNavigationNode* _node = NewObject<UNavigationNode>(GetTransientPackage());
+			_node->InitializeNavigationNode(FVector(x * _gap, y * _gap, ((x * y) % 3) * 20), x != 3 || y == 0);
+			_node->SetNodeIndex(_nodes.Num());
+			_nodes.Add(_node);
+		}
+	for (int x = 0; x < _size; ++x)
+		for (int y = 0; y < _size; ++y)
+			for (int nx = FMath::Max(x - 1, 0); nx <= FMath::Min(x + 1, _size - 1); ++nx)
+				for (int ny = FMath::Max(y - 1, 0); ny <= FMath::Min(y + 1, _size - 1); ++ny)
+					if (nx != x || ny != y)
+						_nodes[x * _size + y]->AddNeighbor(_nodes[nx * _size + ny]);
+
+	//	One way Node Linker over the wall : a shortcut from (0, 5) to (5, 5) only
+	const int _linkStart = 0 * _size + 5;
+	const int _linkEnd = 5 * _size + 5;
+	_nodes[_linkStart]->AddNeighbor(_nodes[_linkEnd]);
+	_nodes[_linkStart]->SetNodeWaypoint(true);
+	_nodes[_linkEnd]->SetNodeWaypoint(true);
+
+	const FNavigationGridLayout _layout = FNavigationGridLayout(FVector::ZeroVector, _gap, _size, _size, true);
+	for (const int _landmarkCount : { 0, 2 })		//	Distance only, then ALT potentials
+	{
+		const FNavigationGraphPtr _graph = FNavigationGraph::Compile(_nodes, _layout, _landmarkCount);
+		TestFalse(TEXT("One way link : graph is not symmetric"), _graph->IsSymmetric);
+
+		//	Cost of a path, negative if it steps between two unlinked Nodes
+		auto _pathCost = [&_graph](const TArray<int>& _path)
+		{
+			float _cost = 0;
+			for (int i = 1; i < _path.Num(); ++i)
+			{
+				if (_graph->FindEdge(_path[i - 1], _path[i]) == INDEX_NONE) return -1.0f;
+				_cost += _graph->EdgeCost(_path[i - 1], _path[i]);
+			}
+			return _cost;
+		};
+
+		FNavigationSearch _search;
+		TArray<int> _path = { };
+		TArray<int> _bidirectionalPath = { };
+		for (int _start = 0; _start < _graph->NodeCount(); ++_start)
+			for (int _end = 0; _end < _graph->NodeCount(); ++_end)
+			{
+				if (_start == _end || !_graph->IsNodeAccessible(_start) || !_graph->IsNodeAccessible(_end)) continue;
+
+				const FString& _query = FString::Printf(TEXT("%d landmarks, %d to %d"), _landmarkCount, _start, _end);
+				const bool _isFound = _search.FindPath(*_graph, _start, _end, _path);
+				const bool _isBidirectionalFound = _search.FindPathBidirectional(*_graph, _start, _end, _bidirectionalPath);
+				if (!TestEqual(FString::Printf(TEXT("%s : same result"), *_query), _isBidirectionalFound, _isFound) || !_isFound) continue;
+
+				TestTrue(FString::Printf(TEXT("%s : path from start to end"), *_query), _bidirectionalPath.Num() > 1 && _bidirectionalPath[0] == _start && _bidirectionalPath.Last() == _end);
+				const float _cost = _pathCost(_bidirectionalPath);
+				TestTrue(FString::Printf(TEXT("%s : every step is an Edge"), *_query), _cost >= 0);
+				TestEqual(FString::Printf(TEXT("%s : same cost"), *_query), _cost, _pathCost(_path), 0.01f);
+			}
+
+		//	The shortcut is only taken one way
+		_search.FindPathBidirectional(*_graph, _linkStart, _linkEnd, _bidirectionalPath);
+		TestEqual(TEXT("Shortcut taken toward its end"), _bidirectionalPath.Num(), 2);
+		_search.FindPathBidirectional(*_graph, _linkEnd, _linkStart, _bidirectionalPath);
+		TestTrue(TEXT("Shortcut not taken backward"), _bidirectionalPath.Num() > 2);
+	}
+	return true;
+}
+
+#endif
@@ -4,21 +4,103 @@
 #include "Components/ActorComponent.h"
 
 #include "NavigationAlgorithm.h"
+#include "NavigationFlowField.h"
+#include "NavigationReplanner.h"
+#include "NavigationPathSubsystem.h"
+#include "NavigationAgentSubsystem.h"
 
 #include "NavigationAgentComponent.generated.h"
 
 class ANavigationMesh;
 
+UENUM()
+enum ENavigationPathQueryMode
+{
+	PathQuerySynchronous UMETA(DisplayName = "Synchronous (Game Thread)"),
+	PathQueryAsynchronous UMETA(DisplayName = "Asynchronous (Worker Threads)"),
+	PathQueryTimeSliced UMETA(DisplayName = "Time Sliced (Game Thread, Frame Budget)"),
+	PathQueryIncremental UMETA(DisplayName = "Incremental (Game Thread, Repairs the Previous Path)")
+};
+
+UENUM()
+enum ENavigationAgentLODMode
+{
+	AgentLODNone UMETA(DisplayName = "None"),
+	AgentLODDistance UMETA(DisplayName = "Distance to the Viewers"),
+	AgentLODSignificance UMETA(DisplayName = "Significance (SetAgentSignificance)")
+};
+
+//	Update settings of an Agent LOD bucket, first bucket is the finest
+USTRUCT()
+struct FNavigationAgentLODLevel
+{
+	GENERATED_BODY()
+
+	//	Distance mode : bucket used up to this distance to the closest viewer (ignored for the last bucket)
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0"))
+	float MaxDistance = 2000;
+	//	Significance mode : bucket used from this significance (ignored for the last bucket)
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0", ClampMax = "1"))
+	float MinSignificance = 0.5f;
+	//	Steering (direction, arrival, rotation) recomputed every interval, the last direction is kept in between (0 = every frame)
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0"))
+	float UpdateInterval = 0;
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0.05"))
+	float PathRecomputeRate = 0.5f;
+	//	Scale of the Node range acceptance : Nodes are reached from farther away (coarse path following)
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "1"))
+	float NodeAcceptanceScale = 1;
+
+	FNavigationAgentLODLevel() { }
+	FNavigationAgentLODLevel(const float _maxDistance, const float _minSignificance, const float _updateInterval, const float _pathRecomputeRate, const float _nodeAcceptanceScale) :
+	MaxDistance(_maxDistance),
+	MinSignificance(_minSignificance),
+	UpdateInterval(_updateInterval),
+	PathRecomputeRate(_pathRecomputeRate),
+	NodeAcceptanceScale(_nodeAcceptanceScale)
+	{ }
+};
+
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class CUSTOMNAVMESH_API UNavigationAgentComponent : public UActorComponent
 {
 	GENERATED_BODY()
+	friend class UNavigationAgentSubsystem;
 
 	UPROPERTY(EditAnywhere, Category = "Navigation Agent | System")
 	ANavigationMesh* NavigationMesh = nullptr;
 	UPROPERTY(EditAnywhere, Category = "Navigation Agent | System", meta = (ClampMin = "0.05"))
 	float PathRecomputeRate = 0.5f;
+	UPROPERTY(EditAnywhere, Category = "Navigation Agent | System")
+	TEnumAsByte<ENavigationPathQueryMode> PathQueryMode = ENavigationPathQueryMode::PathQueryAsynchronous;
+	//	Time sliced queries with a higher priority are computed first
+	UPROPERTY(EditAnywhere, Category = "Navigation Agent | System", meta = (EditCondition = "PathQueryMode == ENavigationPathQueryMode::PathQueryTimeSliced"))
+	uint8 PathQueryPriority = 0;
+	//	Use SearchMode instead of the search mode of the Navigation Mesh
+	UPROPERTY(EditAnywhere, Category = "Navigation Agent | System")
+	bool OverrideSearchMode = false;
+	UPROPERTY(EditAnywhere, Category = "Navigation Agent | System", meta = (EditCondition = "OverrideSearchMode"))
+	TEnumAsByte<ENavigationSearchMode> SearchMode = ENavigationSearchMode::SearchAStar;
+	//	MoveToActor follows a flow field shared with the other Agents moving to the same Node instead of computing its own path
+	UPROPERTY(EditAnywhere, Category = "Navigation Agent | System")
+	bool UseFlowField = false;
+	//	Skip the Nodes of the path the Agent can reach by walking straight (line of sight on the graph, Node Linker Nodes are kept)
+	UPROPERTY(EditAnywhere, Category = "Navigation Agent | System")
+	bool UsePathSmoothing = false;
+	//	Path following simulated by the Navigation Agent Subsystem in one batch with the other Agents, instead of the tick of this component
+	UPROPERTY(EditAnywhere, Category = "Navigation Agent | System")
+	bool UseAgentSubsystem = false;
 	
+	//	Scheduled replans are skipped unless the goal moved to another Node, the navigation changed or the Agent left its path
+	UPROPERTY(EditAnywhere, Category = "Navigation Agent | Replan")
+	bool ReplanOnChangeOnly = true;
+	//	Goal moves shorter than this never trigger a replan
+	UPROPERTY(EditAnywhere, Category = "Navigation Agent | Replan", meta = (ClampMin = "0", EditCondition = "ReplanOnChangeOnly"))
+	float ReplanGoalThreshold = 100;
+	//	Distance to the path segment followed past which the Agent has left its corridor
+	UPROPERTY(EditAnywhere, Category = "Navigation Agent | Replan", meta = (ClampMin = "0", EditCondition = "ReplanOnChangeOnly"))
+	float ReplanCorridorWidth = 200;
+
 	UPROPERTY(EditAnywhere, Category = "Navigation Agent | Agent Settings")
 	FVector AgentFeetLocation = FVector::ZeroVector;
 	
@@ -27,6 +109,23 @@ class CUSTOMNAVMESH_API UNavigationAgentComponent : public UActorComponent
 	
 	UPROPERTY(EditAnywhere, Category = "Navigation Agent | Agent Rotation Settings", meta = (ClampMin = "1", ClampMax = "1000"))
 	float AgentRotationSpeed = 5;
+
+	//	Bucket the Agent by distance or significance, the bucket sets its steering interval, replan rate and path following precision
+	UPROPERTY(EditAnywhere, Category = "Navigation Agent | LOD")
+	TEnumAsByte<ENavigationAgentLODMode> LODMode = ENavigationAgentLODMode::AgentLODNone;
+	UPROPERTY(EditAnywhere, Category = "Navigation Agent | LOD", meta = (EditCondition = "LODMode != ENavigationAgentLODMode::AgentLODNone"))
+	TArray<FNavigationAgentLODLevel> LODLevels = {
+		FNavigationAgentLODLevel(2000, 0.66f, 0, 0.5f, 1),
+		FNavigationAgentLODLevel(6000, 0.33f, 0.1f, 1.5f, 2),
+		FNavigationAgentLODLevel(0, 0, 0.25f, 4, 4)
+	};
+	//	A bucket is left only once the distance is this far past its border (no flickering on the border)
+	UPROPERTY(EditAnywhere, Category = "Navigation Agent | LOD", meta = (ClampMin = "0", EditCondition = "LODMode == ENavigationAgentLODMode::AgentLODDistance"))
+	float LODDistanceHysteresis = 300;
+	UPROPERTY(EditAnywhere, Category = "Navigation Agent | LOD", meta = (ClampMin = "0", ClampMax = "1", EditCondition = "LODMode == ENavigationAgentLODMode::AgentLODSignificance"))
+	float LODSignificanceHysteresis = 0.05f;
+	UPROPERTY(EditAnywhere, Category = "Navigation Agent | LOD", meta = (ClampMin = "0.05", EditCondition = "LODMode != ENavigationAgentLODMode::AgentLODNone"))
+	float LODUpdateInterval = 0.5f;
 	
 	UPROPERTY(VisibleAnywhere)
 	UAlgorithmAStar* NavigationAlgorithm = nullptr;
@@ -53,12 +152,60 @@ class CUSTOMNAVMESH_API UNavigationAgentComponent : public UActorComponent
 	
 	UPROPERTY()
 	FTimerHandle RecomputeTimerHandle;
+	UPROPERTY()
+	FNavigationPathQueryHandle PathQuery;
+	//	Navigation version of the last path request (path cache)
+	UPROPERTY()
+	uint32 PathQueryVersion = 0;
+	//	Search mode of the last path request, after the fallbacks of the Navigation Mesh (path cache)
+	TEnumAsByte<ENavigationSearchMode> PathQuerySearchMode = ENavigationSearchMode::SearchAStar;
+	//	Goal of the last path request (replan triggers)
+	int PathGoalNode = INDEX_NONE;
+	FVector PathGoalLocation = FVector::ZeroVector;
+	//	Last replan scheduled in the Navigation Agent Subsystem, older entries are ignored
+	uint32 ReplanTicket = 0;
+	//	Field followed instead of a path (UseFlowField)
+	FNavigationFlowFieldPtr FlowField = nullptr;
+	//	Search state kept between two paths (Incremental path query mode)
+	TUniquePtr<FNavigationReplanner> Replanner = nullptr;
+	//	Slot in the Navigation Agent Subsystem (UseAgentSubsystem)
+	int SimulationSlot = INDEX_NONE;
+
+	UPROPERTY(VisibleAnywhere, Category = "Navigation Agent | Values")
+	int AgentLOD = 0;
+	UPROPERTY()
+	float AgentSignificance = 1;
+	UPROPERTY()
+	FTimerHandle LODTimerHandle;
+	//	Time since the last steering update and the direction it gave (LOD update interval)
+	float SteeringTimer = 0;
+	FVector SteeringDirection = FVector::ZeroVector;
+	int SteeringNode = INDEX_NONE;
+	//	Ticking at the update interval, SteeringDirection applied every frame by the Navigation Agent Subsystem
+	bool IsSteeringHeld = false;
 
 public:
-	FORCEINLINE const UNavigationNode* AgentPreviousNode() const { return FollowPath.PreviousNode; }
-	FORCEINLINE const UNavigationNode* AgentTargetNode() const { return FollowPath.CurrentNode; }
+	FORCEINLINE int AgentPreviousNode() const { return FollowPath.PreviousNode; }
+	FORCEINLINE int AgentTargetNode() const { return FollowPath.CurrentNode; }
 
 	FORCEINLINE FVector AgentLocation() const { return OwnerPawn ? OwnerPawn->GetActorLocation() + AgentFeetLocation : FVector::ZeroVector; }
+
+	FORCEINLINE int AgentLODLevel() const { return AgentLOD; }
+	//	Settings of the current LOD bucket, nullptr if the Agent has no LOD
+	FORCEINLINE const FNavigationAgentLODLevel* GetLODLevel() const { return LODMode != ENavigationAgentLODMode::AgentLODNone && LODLevels.IsValidIndex(AgentLOD) ? &LODLevels[AgentLOD] : nullptr; }
+	FORCEINLINE float GetPathRecomputeRate() const { const FNavigationAgentLODLevel* _lod = GetLODLevel(); return _lod ? _lod->PathRecomputeRate : PathRecomputeRate; }
+	FORCEINLINE float GetUpdateInterval() const { const FNavigationAgentLODLevel* _lod = GetLODLevel(); return _lod ? _lod->UpdateInterval : 0; }
+	FORCEINLINE float GetNodeRangeAcceptance() const { const FNavigationAgentLODLevel* _lod = GetLODLevel(); return _lod ? AgentNodeRangeAcceptance * _lod->NodeAcceptanceScale : AgentNodeRangeAcceptance; }
+
+	//	Significance of the Agent for the game (0 - 1), picks its LOD bucket in Significance mode
+	UFUNCTION(BlueprintCallable) void SetAgentSignificance(const float _significance);
+	/**
+	 * Bucket of the value, a bucket is only left once the value is past its border by the hysteresis
+	 *
+	 * @param _current			Bucket the Agent is in
+	 * @param _isSignificance	Value is a significance (buckets by MinSignificance), else a distance (buckets by MaxDistance)
+	 */
+	static int SelectLODLevel(const TArray<FNavigationAgentLODLevel>& _levels, const int _current, const float _value, const float _hysteresis, const bool _isSignificance);
 	
 public:
 	UNavigationAgentComponent();
@@ -77,6 +224,7 @@ public:
 	
 private:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 protected:
@@ -92,6 +240,15 @@ protected:
 	bool IsAgentArrivedAtNode() const;
 	//	Make the Agent follow the next Node in his Path
 	void UpdateAgentPathFollowing(); 
+	//	Push the path following state to the Navigation Agent Subsystem (if simulated by it)
+	void SyncAgentSimulation() const;
+
+	#pragma region LOD
+	//	Move the Agent to the bucket of its distance to the viewers or of its significance
+	UFUNCTION() void UpdateAgentLOD();
+	//	Tick of a self ticking Agent at the update interval of its bucket, its direction is applied every frame by the Navigation Agent Subsystem
+	void UpdateTickInterval();
+	#pragma endregion
 
 	#pragma region Enable 
 	UFUNCTION(BlueprintCallable) void SetMovementEnable(const bool _enable);
@@ -101,8 +258,25 @@ protected:
 
 	#pragma region Path
 	UFUNCTION() void RecomputePath();
+	//	Replan after the recompute rate of the Agent (Navigation Agent Subsystem scheduler, timer without it)
+	void ScheduleRecompute();
+	void CancelRecompute();
+	//	Called by the scheduler when the replan is due, false if skipped (nothing changed) and scheduled again
+	bool ProcessScheduledReplan();
+	//	Goal moved to another Node, navigation version changed, or Agent out of its corridor
+	bool ShouldRecomputePath() const;
+	//	Compute a path from the Node to the closest Node of the location
+	void RequestPath(const int _startNode, const FVector& _targetLocation);
+	//	Repair the previous path with the incremental planner, the path is kept as is if nothing relevant changed
+	void ReplanPath(const FNavigationGraphPtr& _graph, const int _startNode, const int _endNode);
 	
 	UFUNCTION() virtual void OnPathReceived(FNavigationNodePath _path);
 	UFUNCTION() virtual void OnPathFailed();
+	void OnPathQueryCompleted(const bool _success, const FNavigationNodePath& _path);
+	void CancelPathQuery();
+	//	Follow the flow field toward _targetNode from _startNode (or from the current Node if already following)
+	void FollowFlowField(const int _startNode, const int _targetNode);
+	//	Read the next Node from the flow field
+	int NextFlowFieldNode();
 	#pragma endregion
 };
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "NavigationAgentSubsystem.generated.h"
+
+class UNavigationAgentComponent;
+
+enum ENavigationAgentSimulationFlag : uint8
+{
+	AgentSimulationNone = 0,
+	AgentSimulationFollowing = 1 << 0,		//	Enabled and following a path that is not completed
+	AgentSimulationMovement = 1 << 1,
+	AgentSimulationRotation = 1 << 2,
+};
+
+//	Replan of an Agent due at DueTime, ignored if the Agent scheduled or cancelled another one since (Ticket)
+struct FNavigationReplanEntry
+{
+	double DueTime = 0;
+	TWeakObjectPtr<UNavigationAgentComponent> Agent = nullptr;
+	uint32 Ticket = 0;
+
+	FORCEINLINE bool operator<(const FNavigationReplanEntry& _other) const { return DueTime < _other.DueTime; }
+};
+
+/**
+ * Path following of the Agents that opt in (UseAgentSubsystem), simulated in one batch per frame instead of one tick per component.
+ * The state is kept as SoA arrays (one slot per Agent) : the pawns are read once, arrival and steering run over contiguous arrays,
+ * then the results are written back to the pawns. Agents push their state when it changes (new path, next Node, enable, LOD...), not every frame.
+ * Agents of a coarse LOD bucket are only gathered and steered every update interval, their last direction is applied in between.
+ * Also schedules the path replans of all the Agents : due replans are run oldest first, at most MaxReplansPerFrame per frame,
+ * and their times are jittered so Agents spawned together drift apart instead of replanning on the same frame.
+ */
+UCLASS()
+class CUSTOMNAVMESH_API UNavigationAgentSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<UNavigationAgentComponent*> Agents = { };
+	UPROPERTY()
+	TArray<APawn*> Pawns = { };
+	TArray<uint8> Flags = { };
+	TArray<FVector> FeetOffsets = { };
+	TArray<float> AcceptanceSquared = { };
+	TArray<float> RotationSpeeds = { };
+	TArray<FVector> Targets = { };			//	Location of the Node each Agent walks to
+	TArray<float> UpdateIntervals = { };	//	Steering interval of the LOD bucket of each Agent
+	TArray<float> UpdateTimers = { };
+
+	//	Per frame values
+	TArray<FVector> Locations = { };
+	TArray<FVector> Velocities = { };
+	TArray<FRotator> Rotations = { };
+	TArray<FVector> Directions = { };		//	Kept between two steering updates
+	TArray<float> StepTimes = { };			//	Time covered by the steering update of this frame, negative if not updated
+	TArray<TWeakObjectPtr<UNavigationAgentComponent>> Arrived = { };
+
+	double LastFrameSeconds = 0;
+
+	//	Replans by due time (min heap)
+	TArray<FNavigationReplanEntry> ReplanQueue = { };
+	int MaxReplansPerFrame = 8;
+	int ReplanCount = 0;
+	int SkippedReplanCount = 0;
+
+	//	Agents ticking themselves at the update interval of their LOD bucket : their last direction is applied every frame in between
+	TArray<TWeakObjectPtr<UNavigationAgentComponent>> HeldAgents = { };
+
+	//	View locations of the players, gathered once per frame for the Agent LODs
+	TArray<FVector> ViewerLocations = { };
+	uint64 ViewerFrame = MAX_uint64;
+
+public:
+	FORCEINLINE int SimulatedAgentCount() const { return Agents.Num(); }
+	FORCEINLINE double LastFrameSimulationTime() const { return LastFrameSeconds; }
+
+	//	Start simulating the Agent (its own tick should be disabled), returns its slot
+	int RegisterAgent(UNavigationAgentComponent* _agent);
+	void UnregisterAgent(UNavigationAgentComponent* _agent);
+	//	Copy the path following state of the Agent in its slot
+	void UpdateAgent(const UNavigationAgentComponent* _agent);
+
+	//	View locations of the local and remote players this frame
+	const TArray<FVector>& GetViewerLocations();
+
+	//	Apply the steering direction of a self ticking Agent every frame while its tick runs at its LOD update interval
+	void HoldAgentSteering(UNavigationAgentComponent* _agent);
+	void ReleaseAgentSteering(UNavigationAgentComponent* _agent);
+
+	#pragma region Replans
+	//	Replan the path of the Agent in about _delay seconds (replaces its previous replan)
+	void ScheduleReplan(UNavigationAgentComponent* _agent, const float _delay);
+	void CancelReplan(UNavigationAgentComponent* _agent);
+
+	//	Replans run since the start
+	FORCEINLINE int GetReplanCount() const { return ReplanCount; }
+	//	Replans due but skipped because nothing relevant changed for their Agent
+	FORCEINLINE int GetSkippedReplanCount() const { return SkippedReplanCount; }
+	FORCEINLINE int GetScheduledReplanCount() const { return ReplanQueue.Num(); }
+
+	//	Replans due in the same frame past this count wait for the next frames
+	UFUNCTION(BlueprintCallable) void SetMaxReplansPerFrame(const int _max);
+	#pragma endregion
+
+private:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	//	Read the pawns of the Agents following a path whose steering update is due
+	void GatherAgents(const float _deltaTime);
+	//	Arrival and steering of the Agents gathered this frame
+	void SimulateAgents();
+	//	Write movement input and rotation to the pawns
+	void ApplyAgents();
+	//	Agents which arrived at their Node move to the next one (can unregister Agents)
+	void ProcessArrivals();
+	//	Movement input of the held Agents (not simulated, one call per pawn)
+	void ApplyHeldSteering();
+	//	Run the due replans within the per frame cap
+	void ProcessReplans();
+};
@@ -2,37 +2,15 @@
 
 #include "CoreMinimal.h"
 
-#include "NavigationNode.h"
+#include "NavigationGraph.h"
 #include "NavigationNodePath.h"
+#include "NavigationSearch.h"
 
 #include "NavigationAlgorithm.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnComputePathCompleted, FNavigationNodePath, _path);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnComputePathFailed);
 
-USTRUCT()
-struct FNodeInfo
-{
-	GENERATED_BODY()
-
-	UPROPERTY()
-	float Cost = 0;
-	UPROPERTY()
-	float Heuristic = 0;
-	UPROPERTY()
-	UNavigationNode* Node = nullptr;
-	UPROPERTY()
-	UNavigationNode* PreviousNode = nullptr;
-
-	FNodeInfo() { }
-	FNodeInfo(const float _cost, const float _heuristic, UNavigationNode* _node, UNavigationNode* _previous) :
-	Cost(_cost),
-	Heuristic(_heuristic),
-	Node(_node),
-	PreviousNode(_previous)
-	{ }
-};
-
 UCLASS()
 class CUSTOMNAVMESH_API UNavigationAlgorithm : public UObject
 {
@@ -52,9 +30,13 @@ class CUSTOMNAVMESH_API UAlgorithmAStar : public UNavigationAlgorithm
 {
 	GENERATED_BODY()
 
+	//	Search data kept between queries (avoid reallocating the per-node arrays for each path)
+	FNavigationSearch Search;
+
 public:
-	void ComputePath(UNavigationNode* _startNode, UNavigationNode* _endNode) const;
+	//	Compute the path with the search mode of the request (paths over several frames are stepped by the Navigation Path Subsystem)
+	void ComputePath(const FNavigationPathRequest& _request);
 
-private:
-	FNavigationNodePath GetPath(const TMap<UNavigationNode*, FNodeInfo>& _grid, UNavigationNode* _startNode, UNavigationNode* _endNode) const;	
+	//	Convert a path of Node indices to a followable path
+	static FNavigationNodePath GetPath(const FNavigationGraph& _graph, const TArray<int>& _path);
 };
\ No newline at end of file
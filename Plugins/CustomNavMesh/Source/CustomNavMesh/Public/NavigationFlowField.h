@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "NavigationGraph.h"
+
+class FNavigationNodeHeap;
+
+/**
+ * Integration field toward a target Node : cost to reach the target and next Node to take from every Node of a graph.
+ * Computed once with a reverse Dijkstra from the target, then shared by every Agent moving to it (each one reads its next Node in O(1)).
+ * Read only once built : a new field is created when the target or the graph changes.
+ */
+class CUSTOMNAVMESH_API FNavigationFlowField
+{
+	FNavigationGraphPtr Graph = nullptr;		//	Graph the field was computed on (kept alive by the field)
+	FNavigationBlockedNodesPtr BlockedNodes = nullptr;	//	Obstacles the field goes around
+	int TargetNode = INDEX_NONE;
+
+	TArray<float> Distance = { };				//	Cost to reach the target (UE_MAX_FLT if it can't be reached)
+	TArray<int> Next = { };						//	Next Node toward the target (INDEX_NONE on the target and unreachable Nodes)
+
+public:
+	FORCEINLINE const FNavigationGraphPtr& FieldGraph() const { return Graph; }
+	FORCEINLINE const FNavigationBlockedNodesPtr& FieldBlockedNodes() const { return BlockedNodes; }
+	FORCEINLINE int FieldTarget() const { return TargetNode; }
+
+	FORCEINLINE bool CanReachTarget(const int _node) const { return Distance.IsValidIndex(_node) && Distance[_node] < UE_MAX_FLT; }
+	FORCEINLINE float TargetDistance(const int _node) const { return Distance.IsValidIndex(_node) ? Distance[_node] : UE_MAX_FLT; }
+	FORCEINLINE int NextNode(const int _node) const { return Next.IsValidIndex(_node) ? Next[_node] : INDEX_NONE; }
+
+	//	Compute the whole field toward _targetNode, paths never cross the _blocked Nodes
+	void Build(const FNavigationGraphPtr& _graph, const int _targetNode, const FNavigationBlockedNodesPtr& _blocked = nullptr);
+	/**
+	 * Compute the field toward _targetNode from the field of a previous target
+	 *
+	 * Costs through the previous target are kept as upper bounds, only the Nodes getting closer to the new target are updated
+	 *
+	 * @return		False if the previous target has no edge to the new one (nothing is computed)
+	 */
+	bool Retarget(const FNavigationFlowField& _previous, const int _targetNode);
+
+	//	Follow the field from _startNode, _outPath goes from _startNode to the target (both included)
+	bool GetPath(const int _startNode, TArray<int>& _outPath) const;
+
+private:
+	//	Dijkstra over the reverse edges from the queued Nodes, only improves Distance
+	void Propagate(FNavigationNodeHeap& _openList);
+};
+
+typedef TSharedPtr<const FNavigationFlowField, ESPMode::ThreadSafe> FNavigationFlowFieldPtr;
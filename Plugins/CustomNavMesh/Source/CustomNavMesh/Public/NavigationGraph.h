@@ -0,0 +1,172 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "NavigationLandmarks.h"
+#include "NavigationMeshSettings.h"
+
+class UNavigationNode;
+struct FNavigationGraph;
+class FNavigationGraphFile;
+
+enum ENavigationNodeFlag : uint8
+{
+	NodeFlagNone = 0,
+	NodeFlagAccessible = 1 << 0,
+	NodeFlagWaypoint = 1 << 1,		//	Node of a Node Linker : never removed by the path smoothing
+};
+
+/**
+ * Uniform grid of buckets over the Nodes XY positions, used to find the closest Node without scanning the whole graph.
+ * Simple grids are indexed directly (one Node per cell), complex (multi layer) grids store their Nodes per cell in CSR form.
+ */
+struct CUSTOMNAVMESH_API FNavigationSpatialIndex
+{
+	float OriginX = 0;
+	float OriginY = 0;
+	float CellSize = 1;
+	int SizeX = 0;
+	int SizeY = 0;
+	bool IsSimpleGrid = false;
+
+	TConstArrayView<int> CellOffsets;	//	Nodes of cell c are in CellNodes[CellOffsets[c], CellOffsets[c + 1]) (complex grid only)
+	TConstArrayView<int> CellNodes;
+
+	//	Build the cells in the arrays given (kept alive with the index by the graph)
+	void Build(const FNavigationGraph& _graph, const FNavigationGridLayout& _layout, TArray<int>& _cellOffsets, TArray<int>& _cellNodes);
+	//	Closest accessible Node within _maxRange (0 = no limit), INDEX_NONE if there is none
+	int FindClosestNode(const FNavigationGraph& _graph, const FVector& _worldLocation, const float _maxRange) const;
+	//	Accessible Nodes of the cells overlapping the XY box (Nodes of the border cells can be slightly outside of it)
+	void FindNodesInBox(const FNavigationGraph& _graph, const FBox2D& _box, TArray<int>& _outNodes) const;
+
+	FORCEINLINE int CellX(const float _x) const { return FMath::Clamp(FMath::RoundToInt((_x - OriginX) / CellSize), 0, SizeX - 1); }
+	FORCEINLINE int CellY(const float _y) const { return FMath::Clamp(FMath::RoundToInt((_y - OriginY) / CellSize), 0, SizeY - 1); }
+};
+
+//	Memory of a compiled graph, the arrays of the graph point into it
+struct FNavigationGraphArrays
+{
+	TArray<float> PositionX = { };
+	TArray<float> PositionY = { };
+	TArray<float> PositionZ = { };
+	TArray<uint8> Flags = { };
+	TArray<int> NeighborOffsets = { };
+	TArray<int> Neighbors = { };
+	TArray<int> ReverseOffsets = { };		//	Empty if the graph is symmetric
+	TArray<int> ReverseNeighbors = { };
+	TArray<int> CellOffsets = { };
+	TArray<int> CellNodes = { };
+};
+
+/**
+ * Compact read-only copy of the Navigation Nodes used by the searches.
+ * Positions are stored as SoA arrays and adjacency as CSR (Offsets + Neighbor indices).
+ * Edge costs only depend on the positions and are computed when read (EdgeCost), a symmetric graph has no reverse arrays of its own :
+ * about 17 bytes per Node plus 4 per edge (49 bytes per Node on a grid of 8 neighbors).
+ * Node indices match the index of the Node in ANavigationMesh::NavigationNodes.
+ * Arrays are views : on the compiled arrays (Compile), in place on a baked file mapped in memory (LoadBakedFile), or on the arrays of the graph
+ * it was made from (WithLandmarks), so a graph is never copied.
+ */
+struct CUSTOMNAVMESH_API FNavigationGraph
+{
+	TConstArrayView<float> PositionX;
+	TConstArrayView<float> PositionY;
+	TConstArrayView<float> PositionZ;
+	TConstArrayView<uint8> Flags;
+
+	TConstArrayView<int> NeighborOffsets;	//	Neighbors of Node i are in [NeighborOffsets[i], NeighborOffsets[i + 1])
+	TConstArrayView<int> Neighbors;
+
+	//	Reverse adjacency (Nodes with an edge toward Node i), edges can be one way (Node Linker)
+	TConstArrayView<int> ReverseOffsets;
+	TConstArrayView<int> ReverseNeighbors;
+	//	Every edge has its way back : the reverse views are the forward ones
+	bool IsSymmetric = false;
+
+	FNavigationGridLayout Layout;
+	FNavigationSpatialIndex SpatialIndex;
+	//	Cost tables of the ALT heuristic (none unless compiled with landmarks)
+	FNavigationLandmarks Landmarks;
+
+	//	Navigation version of the Mesh when the graph was compiled
+	uint32 Version = 0;
+	//	Nodes changed since the graph of the previous version (only if HasChangedNodes, i.e. same Nodes recompiled)
+	TArray<int> ChangedNodes = { };
+	bool HasChangedNodes = false;
+
+private:
+	FNavigationGraphArrays Arrays;
+	TSharedPtr<FNavigationGraphFile, ESPMode::ThreadSafe> File = nullptr;		//	Baked file the arrays point into
+	TSharedPtr<const FNavigationGraph, ESPMode::ThreadSafe> Source = nullptr;	//	Graph the arrays point into (WithLandmarks)
+
+public:
+	FNavigationGraph() { }
+	UE_NONCOPYABLE(FNavigationGraph);
+
+	FORCEINLINE int NodeCount() const { return Flags.Num(); }
+	FORCEINLINE bool IsValidNode(const int _node) const { return Flags.IsValidIndex(_node); }
+	FORCEINLINE bool IsNodeAccessible(const int _node) const { return (Flags[_node] & NodeFlagAccessible) != 0; }
+	FORCEINLINE bool IsNodeWaypoint(const int _node) const { return (Flags[_node] & NodeFlagWaypoint) != 0; }
+	FORCEINLINE FVector NodeLocation(const int _node) const { return FVector(PositionX[_node], PositionY[_node], PositionZ[_node]); }
+
+	FORCEINLINE int NeighborBegin(const int _node) const { return NeighborOffsets[_node]; }
+	FORCEINLINE int NeighborEnd(const int _node) const { return NeighborOffsets[_node + 1]; }
+	FORCEINLINE int ReverseNeighborBegin(const int _node) const { return ReverseOffsets[_node]; }
+	FORCEINLINE int ReverseNeighborEnd(const int _node) const { return ReverseOffsets[_node + 1]; }
+	//	Index in Neighbors of the edge _from -> _to (INDEX_NONE if there is none)
+	int FindEdge(const int _from, const int _to) const;
+
+	//	Cost of a move between two Nodes (step cost + distance)
+	static FORCEINLINE float ComputeEdgeCost(const FVector& _from, const FVector& _to) { return 1 + FVector::Dist(_from, _to); }
+	//	Cost of the edge between two neighbor Nodes, the same both ways
+	FORCEINLINE float EdgeCost(const int _from, const int _to) const { return ComputeEdgeCost(NodeLocation(_from), NodeLocation(_to)); }
+
+	/**
+	 * Build a graph from the Navigation Nodes (edges to inaccessible Nodes are dropped)
+	 *
+	 * @param _landmarkCount	Landmark tables built at once (bake), the Mesh builds the ones of its runtime graphs on a worker thread
+	 */
+	static TSharedRef<FNavigationGraph, ESPMode::ThreadSafe> Compile(const TArray<UNavigationNode*>& _nodes, const FNavigationGridLayout& _layout, const int _landmarkCount = 0);
+	//	Same graph as _source (arrays shared, not copied) with other landmark tables
+	static TSharedRef<FNavigationGraph, ESPMode::ThreadSafe> WithLandmarks(const TSharedRef<const FNavigationGraph, ESPMode::ThreadSafe>& _source, const FNavigationLandmarks& _landmarks);
+	//	Point the arrays to the compiled ones
+	void BindArrays();
+	//	Build the reverse adjacency from the forward one (none if the graph is symmetric)
+	void BuildReverseAdjacency();
+	//	Nodes whose location, accessibility or outgoing edges differ between two compilations of the same Nodes
+	static void FindChangedNodes(const FNavigationGraph& _previous, const FNavigationGraph& _current, TArray<int>& _outNodes);
+	/**
+	 * Save the graph as a baked file used in place when loaded : fixed header, then every array as an aligned block found by its offset and CRC
+	 *
+	 * @param _outChecksum		CRC of the arrays, written in the header (LoadBakedFile rejects a file of another bake)
+	 */
+	bool SaveBakedFile(const FString& _path, uint32& _outChecksum) const;
+	/**
+	 * Graph of a baked file, mapped in memory and used in place (read at once where mapping is not supported). Thread safe.
+	 *
+	 * The header (format, checksum, array sizes), the CRC of every block and every Node index are checked once, so the load reads the whole file.
+	 * @return		nullptr if the file is missing, of another format, of another bake or corrupted
+	 */
+	static TSharedPtr<FNavigationGraph, ESPMode::ThreadSafe> LoadBakedFile(const FString& _path, const uint32 _checksum);
+	static FString GetBakedFilePath(const FString& _root, const FString& _meshName);
+
+	//	Index of the closest accessible Node to the location within _maxRange (0 = no limit), INDEX_NONE if there is none
+	FORCEINLINE int FindClosestNode(const FVector& _worldLocation, const float _maxRange = 0) const { return SpatialIndex.FindClosestNode(*this, _worldLocation, _maxRange); }
+};
+
+typedef TSharedPtr<const FNavigationGraph, ESPMode::ThreadSafe> FNavigationGraphPtr;
+
+/**
+ * Nodes blocked at runtime by the Navigation Obstacles, on top of the accessibility of the graph.
+ * Read-only snapshot published by the Navigation Mesh : a new one is made when an obstacle blocks or frees a Node.
+ */
+struct CUSTOMNAVMESH_API FNavigationBlockedNodes
+{
+	TBitArray<> Blocked;
+	//	Obstacle version of the Mesh when the snapshot was made
+	uint32 Version = 0;
+
+	FORCEINLINE bool IsBlocked(const int _node) const { return Blocked.IsValidIndex(_node) && Blocked[_node]; }
+};
+
+typedef TSharedPtr<const FNavigationBlockedNodes, ESPMode::ThreadSafe> FNavigationBlockedNodesPtr;
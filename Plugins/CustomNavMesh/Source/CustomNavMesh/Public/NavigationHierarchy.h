@@ -0,0 +1,81 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "NavigationGraph.h"
+
+class FNavigationSearch;
+
+struct FNavigationAbstractEdge
+{
+	int Target = INDEX_NONE;		//	Graph index of the target entrance
+	float Cost = 0;
+
+	FNavigationAbstractEdge() { }
+	FNavigationAbstractEdge(const int _target, const float _cost) :
+	Target(_target),
+	Cost(_cost)
+	{ }
+};
+
+/**
+ * Hierarchical layer (HPA*) over a compiled Navigation Graph.
+ * The grid is split in square clusters. Each connected run of edges crossing from a cluster to another one is reduced to a single
+ * entrance edge, and the entrances of a cluster are linked together with their intra cluster cost.
+ * A query searches this small entrance graph first, then only refines the clusters of the corridor it found.
+ */
+class CUSTOMNAVMESH_API FNavigationHierarchy
+{
+	int ClusterSize = 16;
+	float OriginX = 0;
+	float OriginY = 0;
+	float ClusterWorldSize = 1;
+	int ClustersX = 0;
+	int ClustersY = 0;
+
+	TArray<int> NodeCluster = { };						//	Cluster of each Node (from its location, accessible or not)
+	TArray<int> ClusterOffsets = { };					//	Nodes of cluster c are in ClusterNodes[ClusterOffsets[c], ClusterOffsets[c + 1])
+	TArray<int> ClusterNodes = { };
+
+	TMap<uint64, TArray<FIntPoint>> Transitions = { };	//	Directed cluster pair -> entrance edges (From Node, To Node)
+	TArray<TArray<int>> ClusterEntrances = { };
+	TMap<int, TArray<FNavigationAbstractEdge>> AbstractEdges = { };		//	Entrance Node -> abstract edges (intra cluster paths and entrance edges)
+
+public:
+	FORCEINLINE int ClusterCount() const { return ClustersX * ClustersY; }
+	FORCEINLINE int EntranceCount() const { return AbstractEdges.Num(); }
+	FORCEINLINE int NodeClusterIndex(const int _node) const { return NodeCluster[_node]; }
+
+	//	Split the graph in clusters of _clusterSize x _clusterSize grid cells and compute entrances and intra cluster costs
+	void Build(const FNavigationGraph& _graph, const int _clusterSize, FNavigationSearch& _scratch);
+	//	Same clusters as the hierarchy built for _graph (the update can be partial)
+	bool IsCompatible(const FNavigationGraph& _graph, const int _clusterSize) const;
+	//	Rebuild the clusters of the Nodes (and the entrances they share with their neighbor clusters) after an accessibility / neighbor change
+	void RebuildClusters(const FNavigationGraph& _graph, const TArray<int>& _changedNodes, FNavigationSearch& _scratch);
+
+	//	Find a path through the entrance graph and refine it to graph Nodes, _outPath goes from _startNode to _endNode (both included)
+	bool FindPath(const FNavigationGraph& _graph, const int _startNode, const int _endNode, FNavigationSearch& _scratch, TArray<int>& _outPath) const;
+
+private:
+	FORCEINLINE static uint64 PairKey(const int _from, const int _to) { return static_cast<uint64>(static_cast<uint32>(_from)) << 32 | static_cast<uint32>(_to); }
+
+	void ComputeClusterGrid(const FNavigationGraph& _graph, const int _clusterSize);
+	//	Reduce the edges crossing from a cluster to another one to one entrance edge per connected run
+	static void ReduceTransitions(const FNavigationGraph& _graph, TArray<FIntPoint>& _edges);
+	//	Entrances and abstract edges of the clusters (Transitions must be up to date)
+	void UpdateClusters(const FNavigationGraph& _graph, const TSet<int>& _clusters, FNavigationSearch& _scratch);
+	//	Clusters linked to the cluster by at least one edge (both ways)
+	void GetLinkedClusters(const FNavigationGraph& _graph, const int _cluster, TSet<int>& _outClusters) const;
+
+	/**
+	 * Dijkstra restricted to a cluster, results are left in the search state of _scratch
+	 *
+	 * @param _reverse		Follow edges backward (costs are then costs to reach _source)
+	 * @param _stopNode		Stop as soon as this Node is settled (INDEX_NONE = settle the whole cluster)
+	 */
+	void ClusterSearch(const FNavigationGraph& _graph, const int _source, const int _cluster, const bool _reverse, const int _stopNode, FNavigationSearch& _scratch) const;
+	//	Append the path to _target found by the last forward ClusterSearch (without its first Node)
+	static bool AppendClusterPath(const int _source, const int _target, const FNavigationSearch& _scratch, TArray<int>& _outPath);
+};
+
+typedef TSharedPtr<const FNavigationHierarchy, ESPMode::ThreadSafe> FNavigationHierarchyPtr;
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "NavigationGraph.h"
+
+class FNavigationSearch;
+
+/**
+ * Jump Point Search over a simple (uniform 8-connected) grid, working on grid coordinates and an accessibility bitmap.
+ * Straight and diagonal runs through open areas are skipped by jumping, only cells with forced neighbors are queued.
+ * Cells whose graph edges don't match the uniform grid (slopes, Node Linkers...) and their neighbors are jump stops,
+ * they are expanded with their graph edges like plain A*, so the found path stays valid on any simple grid.
+ */
+class CUSTOMNAVMESH_API FNavigationJumpPointGrid
+{
+	int SizeX = 0;
+	int SizeY = 0;
+	float StraightCost = 1;
+	float DiagonalCost = 1;
+
+	TBitArray<> Open;			//	Accessible cells
+	TBitArray<> JumpStop;		//	Irregular cells and their neighbors : jumps stop there and they are fully expanded
+	int IrregularCount = 0;
+
+public:
+	FORCEINLINE int IrregularCellCount() const { return IrregularCount; }
+
+	//	Build the bitmaps from a graph compiled from a simple grid (false if the graph is not a simple grid)
+	bool Build(const FNavigationGraph& _graph);
+
+	//	Find a path with jump points and expand it to every crossed Node, _outPath goes from _startNode to _endNode (both included)
+	bool FindPath(const FNavigationGraph& _graph, const int _startNode, const int _endNode, FNavigationSearch& _scratch, TArray<int>& _outPath) const;
+
+private:
+	FORCEINLINE int CellIndex(const int _x, const int _y) const { return _x * SizeY + _y; }
+	FORCEINLINE bool IsOpen(const int _x, const int _y) const { return _x >= 0 && _y >= 0 && _x < SizeX && _y < SizeY && Open[CellIndex(_x, _y)]; }
+
+	//	Blocked cell next to the move making a cell reachable only through (_x, _y)
+	bool HasForcedNeighbor(const int _x, const int _y, const int _dx, const int _dy) const;
+	//	Next jump point from (_x, _y) in the direction (the cell itself is not checked), INDEX_NONE if the run is blocked
+	int Jump(int _x, int _y, const int _dx, const int _dy, const int _endNode) const;
+};
+
+typedef TSharedPtr<const FNavigationJumpPointGrid, ESPMode::ThreadSafe> FNavigationJumpPointGridPtr;
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FNavigationGraph;
+
+//	Memory of the tables built at runtime, shared by the graph snapshots of the same Nodes
+struct FNavigationLandmarkTables
+{
+	TArray<int> Nodes = { };
+	TArray<uint16> FromCosts = { };
+	TArray<uint16> ToCosts = { };
+};
+
+/**
+ * Landmark distance tables of the ALT heuristic (A*, Landmarks, Triangle inequality).
+ * Shortest path costs from (and to) a few landmark Nodes far from each other give lower bounds of the cost between any two Nodes :
+ * cost(v, t) >= cost(L, t) - cost(L, v) and cost(v, t) >= cost(v, L) - cost(t, L).
+ * Costs are quantized on 16 bits (rounded down, bounds lose one step to stay admissible), one row of Count values per Node.
+ */
+struct CUSTOMNAVMESH_API FNavigationLandmarks
+{
+	static constexpr uint16 Unreachable = MAX_uint16;
+
+	int Count = 0;
+	float Step = 1;					//	Cost of one quantization step
+	bool IsSymmetric = true;		//	No one way edge : costs to the landmarks are the costs from them (ToCosts is empty)
+	//	Tables of a previous graph of the same Nodes, changed since : bounds around the changes can be off (searches may be slightly suboptimal)
+	bool IsApproximate = false;
+
+	TConstArrayView<int> Nodes;		//	Landmark Nodes
+	TConstArrayView<uint16> FromCosts;	//	Cost from landmark l to Node v in FromCosts[v * Count + l]
+	TConstArrayView<uint16> ToCosts;	//	Cost from Node v to landmark l (one way edges only)
+	TSharedPtr<const FNavigationLandmarkTables, ESPMode::ThreadSafe> Tables = nullptr;		//	Memory of the views (none if mapped from a baked file)
+
+	FORCEINLINE bool IsBuilt() const { return Count > 0; }
+
+	/**
+	 * Select the landmarks by farthest point selection and compute their cost tables (one Dijkstra per landmark and direction : run off the game thread)
+	 * A landmark is the Node the farthest from the landmarks already selected, all in the island of the first Node with an edge :
+	 * Nodes of the other islands get no bound (Unreachable) and searches there only use the distance
+	 *
+	 * @param _count	Landmarks to select (less if the island has less Nodes)
+	 */
+	void Build(const FNavigationGraph& _graph, const int _count);
+
+	//	Lower bound of the cost from _node to the target, _targetFrom / _targetTo are the rows of the target (TargetRows)
+	FORCEINLINE float LowerBound(const int _node, const uint16* _targetFrom, const uint16* _targetTo) const
+	{
+		const uint16* _from = FromCosts.GetData() + _node * Count;
+		const uint16* _to = IsSymmetric ? _from : ToCosts.GetData() + _node * Count;
+		int _best = 0;
+		for (int l = 0; l < Count; ++l)
+		{
+			if (_from[l] != Unreachable && _targetFrom[l] != Unreachable)
+				_best = FMath::Max(_best, _targetFrom[l] - _from[l] - 1);
+			if (_to[l] != Unreachable && _targetTo[l] != Unreachable)
+				_best = FMath::Max(_best, _to[l] - _targetTo[l] - 1);
+		}
+		return _best * Step;
+	}
+	FORCEINLINE void TargetRows(const int _target, const uint16*& _outFrom, const uint16*& _outTo) const
+	{
+		_outFrom = FromCosts.GetData() + _target * Count;
+		_outTo = IsSymmetric ? _outFrom : ToCosts.GetData() + _target * Count;
+	}
+};
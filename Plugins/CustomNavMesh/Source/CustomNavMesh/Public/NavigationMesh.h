@@ -10,14 +10,27 @@
 #endif
 
 #include "NavigationNode.h"
+#include "NavigationGraph.h"
+#include "NavigationHierarchy.h"
+#include "NavigationFlowField.h"
+#include "NavigationSearch.h"
+#include "NavigationPathCache.h"
+#include "NavigationPathSmoother.h"
+#include "NavigationRaycast.h"
 #include "NavigationMeshSettings.h"
+#include "NavigationMeshGenerator.h"
+#include "NavigationTile.h"
+#include "NavigationObstacle.h"
 
 #include "NavigationMesh.generated.h"
 
+DECLARE_DYNAMIC_DELEGATE_OneParam(FOnNavigationMeshBuilt, bool, _success);
+
 UCLASS()
 class CUSTOMNAVMESH_API ANavigationMesh : public AActor
 {
 	GENERATED_BODY()
+	friend class FNavigationMeshDirtyPatchTest;		//	Patches the Nodes of a Mesh spawned in a test world
 
 #if WITH_EDITORONLY_DATA
 	UPROPERTY(VisibleAnywhere, Category = "Navigation Mesh | Components")
@@ -30,6 +43,41 @@ class CUSTOMNAVMESH_API ANavigationMesh : public AActor
 	UPROPERTY(VisibleAnywhere, Category = "Navigation Mesh | Nodes")
 	TArray<UNavigationNode*> NavigationNodes = { };
 
+	//	Grid used by the last generation
+	UPROPERTY(VisibleAnywhere, Category = "Navigation Mesh | Nodes")
+	FNavigationGridLayout GridLayout = FNavigationGridLayout();
+
+	//	Graph saved by BakeNavigationGraph in Content/NavigationGraphs (FNavigationGraph::SaveBakedFile), mapped instead of compiling NavigationNodes
+	//	Packaged as loose files (DirectoriesToAlwaysStageAsNonUFS in DefaultGame.ini) : files in a pak can not be mapped
+	UPROPERTY()
+	bool HasBakedGraph = false;
+	//	Checksum of the baked file, the file of another bake is rejected
+	UPROPERTY()
+	uint32 BakedGraphChecksum = 0;
+	//	Nodes still needed as objects once baked, by index (Nodes of the Node Linkers)
+	UPROPERTY(VisibleAnywhere, Category = "Navigation Mesh | Nodes")
+	TMap<int, UNavigationNode*> BakedNodes = { };
+
+	//	Compiled snapshot of NavigationNodes used by the searches (Nodes are only the editing surface)
+	FNavigationGraphPtr NavigationGraph = nullptr;
+	//	Baked graph being mapped on a worker thread (PostLoad), a compilation in the meantime makes it outdated
+	bool IsLoadingBakedGraph = false;
+	//	Cluster layer of NavigationGraph (Hierarchical search mode only), replaced as a whole so running queries keep their own
+	FNavigationHierarchyPtr NavigationHierarchy = nullptr;
+	//	Accessibility bitmap of NavigationGraph for the Jump Point search (simple grids only)
+	FNavigationJumpPointGridPtr NavigationJumpPointGrid = nullptr;
+	//	Landmark tables being built on a worker thread (ALT heuristic), started again for the latest graph when done
+	bool IsBuildingLandmarks = false;
+	//	Incremented each time the navigation data changes (graph compiled...)
+	uint32 NavigationVersion = 0;
+	FNavigationPathCache PathCache;
+	//	String pulling of the Agent paths with its line of sight memo
+	FNavigationPathSmoother PathSmoother;
+	//	Flow fields in use by target Node, a field is released when no Agent references it anymore
+	TMap<int, TWeakPtr<const FNavigationFlowField, ESPMode::ThreadSafe>> FlowFields = { };
+	//	Runtime obstacles (Navigation Obstacle components) and the Nodes they block
+	FNavigationObstacleSet Obstacles;
+
 #if WITH_EDITORONLY_DATA
 	UPROPERTY(EditAnywhere, Category = "Navigation Mesh | Debug")
 	FColor NavigationMeshDebugColor = FColor::Yellow;
@@ -46,37 +94,269 @@ class CUSTOMNAVMESH_API ANavigationMesh : public AActor
 	AActor* StartTest = nullptr;
 	UPROPERTY(EditAnywhere, Category = "Navigation Mesh | Test")
 	AActor* EndTest = nullptr;
+	//	Random queries run by each search of TestSearchModes
+	UPROPERTY(EditAnywhere, Category = "Navigation Mesh | Test", meta = (ClampMin = "1", ClampMax = "100000"))
+	int TestQueryCount = 200;
+
+	UPROPERTY()
+	UAlgorithmAStar* Algo = nullptr;
+#endif
+
+	//	Generation running in the background (the current Nodes stay in use until it completes)
+	FNavigationMeshGeneratorPtr Generator = nullptr;
+	//	Callback of the running runtime build
+	FOnNavigationMeshBuilt OnBuilt;
+	//	Areas changed in the level since the last generation, waiting to be traced again
+	TArray<FBox> DirtyBounds = { };
+	//	Area traced again by Generator (invalid if Generator is a full generation)
+	FBox RebuildingBounds = FBox(ForceInit);
+	float DirtyRebuildTimer = 0;
+
+	//	Tiles (UseTiles) : Nodes of the loaded tiles by tile, free slots of NavigationNodes left by the evicted ones
+	TMap<FIntPoint, FNavigationNodeRange> LoadedTiles = { };
+	TArray<FNavigationNodeRange> FreeNodeRanges = { };
+	//	Tiles being loaded or generated, tiles with no data (not generated)
+	TSet<FIntPoint> PendingTiles = { };
+	TSet<FIntPoint> MissingTiles = { };
+	TMap<FIntPoint, FNavigationMeshGeneratorPtr> TileGenerators = { };
+	TArray<TWeakObjectPtr<AActor>> TileStreamingSources = { };
+	float TileStreamingTimer = 0;
+	//	Tiles were loaded or evicted since the last graph compilation
+	bool TileGraphDirty = false;
+#if WITH_EDITORONLY_DATA
+	TArray<FIntPoint> TileBakeQueue = { };
+
+	//	Bounds of the actors on the ground and obstacle layers (previous area of a moved actor)
+	TMap<TWeakObjectPtr<AActor>, FBox> LayerActorBounds = { };
+	bool HasLayerActorBounds = false;
+	FDelegateHandle ActorMovedHandle;
+	FDelegateHandle ActorAddedHandle;
+	FDelegateHandle ActorDeletedHandle;
+#endif
 
 public:
 	DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnNavMeshGeneration);
+	//	Nodes were generated and the new graph is compiled (closest Node queries already see the new Nodes)
 	UPROPERTY()
 	FOnNavMeshGeneration OnNavMeshGeneration;
-private:
-
-	UPROPERTY()
-	UAlgorithmAStar* Algo = nullptr;
-#endif
 	
 public:	
 	ANavigationMesh();
 
 	UNavigationNode* GetClosestNode(const FVector& _worldLocation);
+	//	Index of the closest accessible Node (INDEX_NONE if there is none)
+	int GetClosestNodeIndex(const FVector& _worldLocation);
+	/**
+	 * Can an Agent walk straight from _start to _end : walked over the graph and the obstacles, no physics trace (FNavigationRaycast)
+	 * Game thread : worker threads call FNavigationRaycast::Raycast with the GetNavigationGraph() and GetBlockedNodes() snapshots
+	 *
+	 * @return		true if _end is reached, _outHit tells where the ray stopped otherwise
+	 */
+	bool NavigationRaycast(const FVector& _start, const FVector& _end, FNavigationRaycastHit& _outHit);
+
+	FORCEINLINE const TArray<UNavigationNode*>& GetNavigationNodes() const { return NavigationNodes; }
+	FORCEINLINE UNavigationNode* GetNavigationNode(const int _index) const { return NavigationNodes.IsValidIndex(_index) ? NavigationNodes[_index] : BakedNodes.FindRef(_index); }
+	//	Graph saved in its compact form : Nodes only exist as objects where they are still referenced (Node Linkers)
+	FORCEINLINE bool IsNavigationGraphBaked() const { return !NavMeshSettings.UseTiles && HasBakedGraph; }
+
+	//	Current graph snapshot (compiled on first use)
+	const FNavigationGraphPtr& GetNavigationGraph();
+	//	Rebuild the graph snapshot from NavigationNodes, call it after any Node / Neighbor edit (baked graph : mapped again)
+	void CompileNavigationGraph();
+	FORCEINLINE const FNavigationHierarchyPtr& GetNavigationHierarchy() const { return NavigationHierarchy; }
+	FORCEINLINE const FNavigationJumpPointGridPtr& GetNavigationJumpPointGrid() const { return NavigationJumpPointGrid; }
+	FORCEINLINE ENavigationSearchMode GetSearchMode() const { return NavMeshSettings.SearchMode; }
+	//	Query between two Nodes using the search mode of the settings (falls back to A* if the mode data is not built)
+	FNavigationPathRequest MakePathRequest(const int _startNode, const int _endNode);
+	//	Query between two Nodes using _mode (falls back to A* if the mode data is not built)
+	FNavigationPathRequest MakePathRequest(const int _startNode, const int _endNode, const ENavigationSearchMode _mode);
+
+	//	Changes when the graph is compiled or an obstacle blocks / frees a Node
+	FORCEINLINE uint32 GetNavigationVersion() const { return NavigationVersion + Obstacles.GetVersion(); }
+	FORCEINLINE const FNavigationPathCache& GetPathCache() const { return PathCache; }
+	//	Whether _mode finds shortest paths on the current graph (not hierarchical, no approximate landmarks)
+	bool IsOptimalSearchMode(const ENavigationSearchMode _mode) const;
+	//	Cached path from _startNode to _endNode found by _mode for the current navigation version
+	bool FindCachedPath(const int _startNode, const int _endNode, const ENavigationSearchMode _mode, TArray<int>& _outPath);
+	//	Cache a path found by _mode with the navigation _version (ignored if the navigation changed since)
+	void AddCachedPath(const uint32 _version, const ENavigationSearchMode _mode, const TArray<int>& _path);
+	FORCEINLINE const FNavigationPathSmoother& GetPathSmoother() const { return PathSmoother; }
+	//	Remove the Nodes of the path an Agent can skip by walking straight (Node Linker Nodes are kept)
+	void SmoothNodePath(FNavigationNodePath& _path);
+
+	/**
+	 * Flow field toward the Node shared by all its users, computed on the first request
+	 *
+	 * @param _previous		Field used by the caller before its target moved, repaired instead of recomputed if the new target is a neighbor of its target
+	 */
+	FNavigationFlowFieldPtr AcquireFlowField(const int _targetNode, const FNavigationFlowFieldPtr& _previous = nullptr);
+
+	//	Call when an Agent arrived at the Node
+	void NodePassedBy(const int _node, AActor* _actor) const;
+
+#pragma region Obstacles
+	//	Block the Nodes inside the shape until the obstacle is removed, returns the obstacle id
+	int AddNavigationObstacle(const FNavigationObstacleShape& _shape);
+	//	Move or resize an obstacle (only the Nodes it left or entered change)
+	void UpdateNavigationObstacle(const int _id, const FNavigationObstacleShape& _shape);
+	void RemoveNavigationObstacle(const int _id);
+	//	Nodes blocked by the obstacles, nullptr if none (snapshot : kept valid by its users)
+	FORCEINLINE FNavigationBlockedNodesPtr GetBlockedNodes() { return Obstacles.GetSnapshot(); }
+	FORCEINLINE int GetNavigationObstacleCount() const { return Obstacles.ObstacleCount(); }
+#pragma endregion
+
+#pragma region Navigation Mesh Build
+	/**
+	 * Generate the Navigation Mesh of a region in the background (packaged games included)
+	 *
+	 * The current Nodes and graph stay in use until the build completes, the new graph snapshot then replaces them at once.
+	 * Starting a build cancels the running one.
+	 *
+	 * @param _bounds			Region to generate (top of the box = grid height), the grid of the settings is used if the box is not valid
+	 * @param _isSimpleGrid		One Node per grid cell (Simple) or one per ground layer (Complex)
+	 * @param _onCompleted		Called on the game thread, false if the build failed, was over the memory budget or was cancelled
+	 * @return					False if the build could not start (_onCompleted is not called)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Navigation Mesh")
+	bool BuildNavigationMesh(const FBox& _bounds, const bool _isSimpleGrid, const FOnNavigationMeshBuilt& _onCompleted);
+	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Navigation Mesh | Utils")
+	void CancelNavigationMeshGeneration();
+
+	FORCEINLINE bool IsGeneratingNavigationMesh() const { return Generator.IsValid(); }
+	//	Progress of the background generation (0 - 1)
+	FORCEINLINE float GetGenerationProgress() const { return Generator ? Generator->Progress() : 1.0f; }
+
+	//	Mark an area of the level as changed : only the cells around it are traced again (after DirtyRebuildDelay, or with RebuildDirtyRegions)
+	UFUNCTION(BlueprintCallable, Category = "Navigation Mesh")
+	void MarkDirtyBounds(const FBox& _bounds);
+	//	Trace the dirty regions again and patch the Nodes around them (one region after the other)
+	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Navigation Mesh | Utils")
+	void RebuildDirtyRegions();
+	FORCEINLINE bool HasDirtyRegions() const { return !DirtyBounds.IsEmpty() || RebuildingBounds.IsValid; }
+#pragma endregion
+
+#pragma region Tiles
+	FORCEINLINE bool UsesTiles() const { return NavMeshSettings.UseTiles; }
+	FORCEINLINE FNavigationTileGrid GetTileGrid() const { return FNavigationTileGrid(GetActorLocation(), NavMeshSettings.NavigationGridGap, NavMeshSettings.NavigationGridSizeX, NavMeshSettings.NavigationGridSizeY, NavMeshSettings.TileSize); }
+	FORCEINLINE int GetLoadedTileCount() const { return LoadedTiles.Num(); }
+	FORCEINLINE bool IsTileLoaded(const FIntPoint& _coord) const { return LoadedTiles.Contains(_coord); }
+	//	Tiles around the actor are kept loaded while it is registered (Agents register themselves, player pawns are always used)
+	void AddTileStreamingSource(AActor* _actor);
+	void RemoveTileStreamingSource(AActor* _actor);
+#pragma endregion
 
 private:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaTime) override;
+	virtual void PostLoad() override;
 
-#if WITH_EDITOR
-	virtual bool ShouldTickIfViewportsOnly() const override { return Debug; }
-#endif
+	//	Give each Node its index in NavigationNodes
+	void UpdateNodesIndex();
+	FNavigationGridLayout GetCompileLayout() const;
+	//	Landmarks of the compiled graphs (0 if the heuristic does not use them)
+	int GetCompileLandmarkCount() const;
+	//	Publish a new graph snapshot : version, changed Nodes, obstacles, hierarchy and Jump Point grid
+	void SetNavigationGraph(const TSharedRef<FNavigationGraph, ESPMode::ThreadSafe>& _graph);
+	//	Graph saved by BakeNavigationGraph (nullptr if the file is missing or not valid)
+	TSharedPtr<FNavigationGraph, ESPMode::ThreadSafe> LoadBakedNavigationGraph() const;
+	//	Fallback of a baked graph that can not be loaded : back to Navigation Nodes, generated again from the level with the saved layout
+	void DropInvalidBakedNavigationGraph();
+	//	Map the baked graph on a worker thread, the graph is published on the game thread (OnBakedNavigationGraphLoaded)
+	void LoadBakedNavigationGraphAsync();
+	void OnBakedNavigationGraphLoaded(const TSharedPtr<FNavigationGraph, ESPMode::ThreadSafe>& _graph);
+	FString GetBakedGraphPath() const;
+	void ClearBakedNavigationGraph();
+	//	Build the hierarchy of the new graph, only the clusters changed since _previousGraph are rebuilt when possible
+	void UpdateNavigationHierarchy(const FNavigationGraphPtr& _previousGraph);
+	//	Build the Jump Point grid of the new graph (none if the graph is not a simple grid)
+	void UpdateNavigationJumpPointGrid();
+	//	Landmark tables of the new graph : the ones of the previous graph of the same Nodes, marked approximate if the graph changed
+	void UpdateNavigationLandmarks(FNavigationGraph& _graph, const FNavigationGraphPtr& _previousGraph) const;
+	//	Build the exact tables of NavigationGraph on a worker thread, published as a new snapshot (OnNavigationLandmarksBuilt)
+	void BuildNavigationLandmarksAsync();
+	void OnNavigationLandmarksBuilt(const FNavigationGraphPtr& _graph, const FNavigationLandmarks& _landmarks);
+
+	virtual void Destroyed() override;
+	virtual void BeginDestroy() override;
 
-#if WITH_EDITOR
 	#pragma region Navigation Mesh Init 
+	/**
+	 * Trace the grid in the background, Nodes are created on the game thread once done
+	 *
+	 * @param _memoryBudget		Max memory of the generated Nodes in bytes (0 = no limit)
+	 */
+	bool StartNavigationMeshGeneration(const FNavigationMeshSettings& _settings, const FNavigationGridLayout& _layout, const int64 _memoryBudget, const FOnNavigationMeshBuilt& _onCompleted);
+	void CompleteNavigationMeshGeneration();
+	void GenerateNodesNeighbors(const FNavigationMeshGenerator& _generator);
+	#pragma endregion
+
+	#pragma region Dirty Regions
+	//	Update the Nodes of the re-traced cells in place (first = first cell of the region in the grid), then their edges
+	void CompleteDirtyRegionRebuild(const FIntPoint& _first);
+	void PatchDirtyRegionSimple(const FIntPoint& _first, const FNavigationGridLayout& _region, const TArray<FNavigationGenerationSample>& _samples);
+	//	Nodes of a re-traced column are reused top to bottom (edges rebuilt from scratch), extra ones are removed and missing ones created in free slots
+	void PatchDirtyRegionComplex(const FIntPoint& _first, const FNavigationGridLayout& _region, const TArray<FNavigationGenerationSample>& _samples);
+	//	The patches rebuild every edge between close Nodes : add again the edges of the Node Linkers with a Node in the patched cells
+	void RestoreNodeLinks(const FIntRect& _patched);
+	FORCEINLINE FIntPoint GetGridCell(const FVector& _location) const
+	{
+		return FIntPoint(FMath::RoundToInt((_location.X - GridLayout.Origin.X) / GridLayout.Gap), FMath::RoundToInt((_location.Y - GridLayout.Origin.Y) / GridLayout.Gap));
+	}
+	#pragma endregion
+
+	#pragma region Tiles
+	//	Load the tiles in range of the streaming sources and evict the ones out of range
+	void UpdateTileStreaming();
+	void GetTileStreamingLocations(TArray<FVector>& _outLocations);
+	//	Distance between the tile and its closest streaming source
+	float GetTileSourceDistance(const FIntPoint& _coord, const TArray<FVector>& _sources) const;
+	//	Read the tile file in the background, generate the tile if there is none
+	void RequestTile(const FIntPoint& _coord);
+	void OnTileReady(const FIntPoint& _coord, const FNavigationTileDataPtr& _tile);
+	void OnTileMissing(const FIntPoint& _coord);
+	//	Trace the tile in the background, _onCompleted is called on the game thread (never called if cancelled)
+	bool GenerateTile(const FIntPoint& _coord, TFunction<void(const FNavigationTileDataPtr&)> _onCompleted);
+	void CancelTileRequests();
+
+	//	Create the Nodes of the tile in free slots of NavigationNodes and stitch them to the loaded tiles around
+	void LoadTile(const FNavigationTileData& _tile);
+	void UnloadTile(const FIntPoint& _coord);
+	//	Link the border Nodes of the tile to the ones of the loaded tiles around
+	void StitchTile(const FIntPoint& _coord);
+	int AllocateNodeRange(const int _count);
+	void ReleaseNodeRange(const FNavigationNodeRange& _range);
+	//	Name of the tile and baked graph files of this Navigation Mesh (level + actor)
+	FString GetTileMeshName() const;
+	#pragma endregion
+
+#if WITH_EDITOR
+	virtual bool ShouldTickIfViewportsOnly() const override { return Debug || HasDirtyRegions(); }
+	virtual void PostRegisterAllComponents() override;
+
+	#pragma region Dirty Regions Editor
+	//	Track the actors of the level on the ground and obstacle layers (edited world only)
+	void BindLevelActorEvents();
+	void UnbindLevelActorEvents();
+	void OnLevelActorMoved(AActor* _actor);
+	void OnLevelActorDeleted(AActor* _actor);
+	//	Actor with a collision on the ground or obstacle layers, within the Navigation Mesh area
+	bool IsNavigationLayerActor(const AActor* _actor) const;
+	void CacheLayerActorBounds();
+	#pragma endregion
+
+	#pragma region Navigation Mesh Init Editor
 	UFUNCTION(CallInEditor, Category = "Navigation Mesh | Utils") void GenerateNavigationMeshSimple();
 	UFUNCTION(CallInEditor, Category = "Navigation Mesh | Utils") void GenerateNavigationMeshComplex();
-	void GenerateNodesNeighborsSimple();
-	void GenerateNodesNeighborsComplex();
-	TArray<UNavigationNode*> GetCloseNodes(const UNavigationNode* _from, const float _range);
-	bool CheckAgentCanWalkBetweenNodes(const UNavigationNode* _from, const UNavigationNode* _to, const float& _range) const;
+	void StartNavigationMeshGeneration(const bool _isSimpleGrid);
+	//	Generate all the tiles of the grid one after the other and save them in Content/NavigationTiles (packaged as a non asset directory)
+	UFUNCTION(CallInEditor, Category = "Navigation Mesh | Utils") void BakeNavigationTiles();
+	void BakeNextTile();
+	//	Save the compiled graph in its compact form in Content/NavigationGraphs and drop the Node objects (the ones of the Node Linkers are kept)
+	//	The directory must be staged outside of the pak files (non UFS) to be mapped in memory, it is read at once otherwise
+	UFUNCTION(CallInEditor, Category = "Navigation Mesh | Utils") void BakeNavigationGraph();
+	//	Create the Node objects again from the baked graph, to edit them
+	UFUNCTION(CallInEditor, Category = "Navigation Mesh | Utils") void UnbakeNavigationGraph();
 	#pragma endregion
 
 	#pragma region Navigation Mesh Debug 
@@ -87,6 +367,10 @@ private:
 	#pragma region Test
 	UFUNCTION(CallInEditor, Category = "Navigation Mesh | Test") void TestGetPath();
 	UFUNCTION(CallInEditor, Category = "Navigation Mesh | Test") void TestGetClose();
+	//	Raycast over the graph from StartTest to EndTest : green until the hit, red after it
+	UFUNCTION(CallInEditor, Category = "Navigation Mesh | Test") void TestRaycast();
+	//	Run the same random queries with A* and Bidirectional A*, log the expanded Nodes, the path costs and the time of each
+	UFUNCTION(CallInEditor, Category = "Navigation Mesh | Test") void TestSearchModes();
 	UFUNCTION() void TestPath(FNavigationNodePath _path);
 	UFUNCTION() void TestPathFail();
 	#pragma endregion
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+
+#include "NavigationMeshSettings.h"
+
+#include <atomic>
+
+//	Node location and accessibility found by the generation traces
+struct FNavigationGenerationSample
+{
+	FVector Location = FVector::ZeroVector;
+	bool IsAccessible = false;
+
+	FNavigationGenerationSample() { }
+	FNavigationGenerationSample(const FVector& _location, const bool _isAccessible) :
+	Location(_location),
+	IsAccessible(_isAccessible)
+	{ }
+};
+
+/**
+ * Runs the generation of a Navigation Mesh in the background, in the editor and in packaged games.
+ * Grid sample positions are computed in bulk, then the ground, obstacle and clearance queries are spread over worker threads (ParallelFor),
+ * then the neighbors of the samples are found. Only read only scene queries run off the game thread, under the read lock of the physics scene
+ * (the game thread writes bodies under its write lock) : Nodes are created on the game thread from the samples once completed.
+ */
+class CUSTOMNAVMESH_API FNavigationMeshGenerator : public TSharedFromThis<FNavigationMeshGenerator, ESPMode::ThreadSafe>
+{
+	TWeakObjectPtr<UWorld> World = nullptr;
+	FNavigationMeshSettings Settings;
+	FNavigationGridLayout Layout;
+
+	TArray<FNavigationGenerationSample> Samples = { };
+	TArray<int> NeighborOffsets = { };			//	Neighbors of sample i are in [NeighborOffsets[i], NeighborOffsets[i + 1])
+	TArray<int> Neighbors = { };
+	int64 MemoryBudget = 0;
+	bool IsOverBudget = false;
+
+	TFuture<void> Task;
+	std::atomic<bool> Cancelled { false };
+	std::atomic<int> DoneWork { 0 };
+	int TotalWork = 1;
+	double StartTime = 0;
+
+public:
+	//	_memoryBudget : max memory of the generated Nodes in bytes (0 = no limit)
+	FNavigationMeshGenerator(UWorld* _world, const FNavigationMeshSettings& _settings, const FNavigationGridLayout& _layout, const int64 _memoryBudget = 0);
+
+	//	Approximate memory used by a Node once created and compiled (Node object, neighbors and graph data)
+	static int64 EstimateNodeMemory();
+
+	FORCEINLINE const FNavigationMeshSettings& GenerationSettings() const { return Settings; }
+	FORCEINLINE const FNavigationGridLayout& GenerationLayout() const { return Layout; }
+	//	Samples in Node order (simple grid : one per cell, X * SizeY + Y), only valid once completed
+	FORCEINLINE const TArray<FNavigationGenerationSample>& GenerationSamples() const { return Samples; }
+	FORCEINLINE int SampleNeighborBegin(const int _sample) const { return NeighborOffsets[_sample]; }
+	FORCEINLINE int SampleNeighborEnd(const int _sample) const { return NeighborOffsets[_sample + 1]; }
+	FORCEINLINE int SampleNeighbor(const int _index) const { return Neighbors[_index]; }
+	//	More Nodes than the memory budget allows (nothing to create)
+	FORCEINLINE bool IsOverMemoryBudget() const { return IsOverBudget; }
+	FORCEINLINE bool IsCancelled() const { return Cancelled.load(std::memory_order_relaxed); }
+	FORCEINLINE float Progress() const { return FMath::Clamp(static_cast<float>(DoneWork.load(std::memory_order_relaxed)) / TotalWork, 0.0f, 1.0f); }
+	FORCEINLINE double ElapsedTime() const { return FPlatformTime::Seconds() - StartTime; }
+
+	//	Start the traces in the background, _onCompleted is called on the game thread (never called if cancelled)
+	void Start(TFunction<void()> _onCompleted);
+	//	Stop the traces as soon as possible
+	void Cancel();
+	//	Block until the background work is done (e.g. before destroying the world)
+	void Wait();
+	//	Hand the samples and their neighbors over (completed generation only, the generator is left empty)
+	void MoveResults(TArray<FNavigationGenerationSample>& _outSamples, TArray<int>& _outNeighborOffsets, TArray<int>& _outNeighbors);
+
+private:
+	void Run();
+	void TraceSimpleGrid();
+	void TraceComplexGrid();
+	//	Check the budget for _nodeCount Nodes
+	bool CheckMemoryBudget(const int64 _nodeCount);
+
+	//	Neighbors from the grid layout : Line X -> All Y Node -> Next Line X...
+	void GenerateNeighborsSimple();
+	//	Neighbors within walk range, found with a spatial hash
+	void GenerateNeighborsComplex();
+	bool CheckAgentCanWalkBetweenSamples(const int _from, const int _to, const float _range) const;
+	void SetNeighbors(const TArray<TArray<int>>& _neighbors);
+	//	Obstacle range and Agent clearance checks (game thread free, call under the scene read lock)
+	bool CheckLocationAccessibility(const UWorld* _world, const FVector& _location) const;
+	FORCEINLINE FVector CellLocation(const int _x, const int _y) const { return Layout.Origin + FVector(_x * Layout.Gap, _y * Layout.Gap, 0); }
+};
+
+typedef TSharedPtr<FNavigationMeshGenerator, ESPMode::ThreadSafe> FNavigationMeshGeneratorPtr;
@@ -2,14 +2,31 @@
 
 #include "NavigationMeshSettings.generated.h"
 
+UENUM()
+enum ENavigationSearchMode
+{
+	SearchAStar UMETA(DisplayName = "A*"),
+	SearchHierarchical UMETA(DisplayName = "Hierarchical A* (HPA*, long distance)"),
+	SearchJumpPoint UMETA(DisplayName = "Jump Point Search (simple grids only)"),
+	SearchBidirectional UMETA(DisplayName = "Bidirectional A* (long distance)")
+};
+
+UENUM()
+enum ENavigationHeuristic
+{
+	HeuristicDistance UMETA(DisplayName = "Distance"),
+	HeuristicLandmarks UMETA(DisplayName = "ALT (distance + landmarks)")
+};
+
 USTRUCT()
 struct FNavigationMeshSettings
 {
 	GENERATED_BODY()
 		
-	UPROPERTY(EditAnywhere, Category = "Navigation Mesh | Settings | Nav Grid", meta = (ClampMin = "1", ClampMax = "500"))
+	//	Cells of the grid (split in tiles if UseTiles)
+	UPROPERTY(EditAnywhere, Category = "Navigation Mesh | Settings | Nav Grid", meta = (ClampMin = "1"))
 	int NavigationGridSizeX = 15;
-	UPROPERTY(EditAnywhere, Category = "Navigation Mesh | Settings | Nav Grid", meta = (ClampMin = "1", ClampMax = "500"))
+	UPROPERTY(EditAnywhere, Category = "Navigation Mesh | Settings | Nav Grid", meta = (ClampMin = "1"))
 	int NavigationGridSizeY = 15;
 	//	Gap between Nodes
 	UPROPERTY(EditAnywhere, Category = "Navigation Mesh | Settings | Nav Grid", meta = (ClampMin = "1", ClampMax = "1000"))
@@ -37,6 +54,94 @@ struct FNavigationMeshSettings
 	TArray<TEnumAsByte<EObjectTypeQuery>> GroundLayers = { };
 	UPROPERTY(EditAnywhere, Category = "Navigation Mesh | Settings | Nav Grid")
 	TArray<TEnumAsByte<EObjectTypeQuery>> ObstacleLayers = { };
+
+	//	Max distance between a location and its closest Node (0 = no limit)
+	UPROPERTY(EditAnywhere, Category = "Navigation Mesh | Settings | Query", meta = (ClampMin = "0", ClampMax = "100000"))
+	float ClosestNodeSearchRange = 0;
+	//	Number of paths kept in the Navigation Mesh path cache (0 = no cache)
+	UPROPERTY(EditAnywhere, Category = "Navigation Mesh | Settings | Query", meta = (ClampMin = "0", ClampMax = "65536"))
+	int PathCacheSize = 256;
+	//	Number of Node pairs whose line of sight is kept by the path smoothing (0 = tested each time)
+	UPROPERTY(EditAnywhere, Category = "Navigation Mesh | Settings | Query", meta = (ClampMin = "0", ClampMax = "1048576"))
+	int VisibilityCacheSize = 4096;
+
+	//	Search used by the path requests of this Navigation Mesh
+	UPROPERTY(EditAnywhere, Category = "Navigation Mesh | Settings | Query")
+	TEnumAsByte<ENavigationSearchMode> SearchMode = ENavigationSearchMode::SearchAStar;
+
+	//	Estimate guiding the A* searches, landmark tables are computed with each compilation and baked with the graph (not used with tiles)
+	UPROPERTY(EditAnywhere, Category = "Navigation Mesh | Settings | Query")
+	TEnumAsByte<ENavigationHeuristic> Heuristic = ENavigationHeuristic::HeuristicDistance;
+	//	Landmarks of the ALT heuristic (2 bytes per Node and landmark, twice if the Mesh has one way links)
+	UPROPERTY(EditAnywhere, Category = "Navigation Mesh | Settings | Query", meta = (ClampMin = "1", ClampMax = "32", EditCondition = "Heuristic == ENavigationHeuristic::HeuristicLandmarks"))
+	int LandmarkCount = 8;
+
+	//	Size of a cluster of the hierarchical search (in grid cells)
+	UPROPERTY(EditAnywhere, Category = "Navigation Mesh | Settings | Hierarchy", meta = (ClampMin = "4", ClampMax = "128", EditCondition = "SearchMode == ENavigationSearchMode::SearchHierarchical"))
+	int HierarchyClusterSize = 16;
+
+	//	Max memory of the Nodes created by a runtime build (BuildNavigationMesh), in MB (0 = no limit)
+	UPROPERTY(EditAnywhere, Category = "Navigation Mesh | Settings | Runtime", meta = (ClampMin = "0", ClampMax = "4096"))
+	int RuntimeMemoryBudgetMB = 0;
+
+	//	Re-trace the dirty regions (actors moved, added or removed on the ground or obstacle layers) once the edits settle
+	UPROPERTY(EditAnywhere, Category = "Navigation Mesh | Settings | Rebuild")
+	bool AutoRebuildDirtyRegions = true;
+	//	Seconds without a new dirty region before the rebuild starts
+	UPROPERTY(EditAnywhere, Category = "Navigation Mesh | Settings | Rebuild", meta = (ClampMin = "0", ClampMax = "10", EditCondition = "AutoRebuildDirtyRegions"))
+	float DirtyRebuildDelay = 0.5f;
+
+	//	Split the grid in tiles streamed around the Agents and the players instead of keeping all the Nodes loaded
+	UPROPERTY(EditAnywhere, Category = "Navigation Mesh | Settings | Tiles")
+	bool UseTiles = false;
+	//	Cells per tile side
+	UPROPERTY(EditAnywhere, Category = "Navigation Mesh | Settings | Tiles", meta = (ClampMin = "4", ClampMax = "1024", EditCondition = "UseTiles"))
+	int TileSize = 64;
+	UPROPERTY(EditAnywhere, Category = "Navigation Mesh | Settings | Tiles", meta = (EditCondition = "UseTiles"))
+	bool TileSimpleGrid = true;
+	//	Tiles closer than this to a streaming source are loaded
+	UPROPERTY(EditAnywhere, Category = "Navigation Mesh | Settings | Tiles", meta = (ClampMin = "0", EditCondition = "UseTiles"))
+	float TileLoadRange = 5000;
+	//	Tiles further than this from every streaming source are evicted (>= load range, avoids reloading tiles on the range edge)
+	UPROPERTY(EditAnywhere, Category = "Navigation Mesh | Settings | Tiles", meta = (ClampMin = "0", EditCondition = "UseTiles"))
+	float TileUnloadRange = 7000;
+	//	Seconds between two streaming updates
+	UPROPERTY(EditAnywhere, Category = "Navigation Mesh | Settings | Tiles", meta = (ClampMin = "0", ClampMax = "10", EditCondition = "UseTiles"))
+	float TileStreamingInterval = 0.5f;
+	//	Tiles loaded or generated at the same time
+	UPROPERTY(EditAnywhere, Category = "Navigation Mesh | Settings | Tiles", meta = (ClampMin = "1", ClampMax = "64", EditCondition = "UseTiles"))
+	int TileMaxPendingRequests = 4;
+	//	Tiles without a baked file are generated in the background (and saved to Saved/NavigationTiles)
+	UPROPERTY(EditAnywhere, Category = "Navigation Mesh | Settings | Tiles", meta = (EditCondition = "UseTiles"))
+	bool GenerateMissingTiles = true;
 	
 	FNavigationMeshSettings() { }
+};
+
+USTRUCT()
+struct FNavigationGridLayout
+{
+	GENERATED_BODY()
+
+	//	Location of the first Node of the grid (Navigation Mesh location when generated)
+	UPROPERTY(VisibleAnywhere)
+	FVector Origin = FVector::ZeroVector;
+	UPROPERTY(VisibleAnywhere)
+	float Gap = 0;
+	UPROPERTY(VisibleAnywhere)
+	int SizeX = 0;
+	UPROPERTY(VisibleAnywhere)
+	int SizeY = 0;
+	//	One Node per grid cell, Node index = X * SizeY + Y (Simple generation)
+	UPROPERTY(VisibleAnywhere)
+	bool IsSimpleGrid = false;
+
+	FNavigationGridLayout() { }
+	FNavigationGridLayout(const FVector& _origin, const float _gap, const int _sizeX, const int _sizeY, const bool _isSimpleGrid) :
+	Origin(_origin),
+	Gap(_gap),
+	SizeX(_sizeX),
+	SizeY(_sizeY),
+	IsSimpleGrid(_isSimpleGrid)
+	{ }
 };
\ No newline at end of file
@@ -20,33 +20,43 @@ public:
 private:
 	UPROPERTY(VisibleAnywhere)	
 	bool IsAccessible = true;
+	//	Node of a Node Linker : kept as a waypoint by the path smoothing
+	UPROPERTY(VisibleAnywhere)
+	bool IsWaypoint = false;
+	//	Index of the Node in its Navigation Mesh (dense index used by the search)
+	UPROPERTY(VisibleAnywhere)
+	int Index = INDEX_NONE;
 	
 	UPROPERTY(VisibleAnywhere)
 	FVector Location = FVector::ZeroVector;
 	UPROPERTY(VisibleAnywhere)
 	TArray<UNavigationNode*> Neighbors = { };
+	//	Lookup copy of Neighbors for duplicate checks (rebuilt when out of sync, e.g. after load)
+	mutable TSet<const UNavigationNode*> NeighborSet = { };
 	
 public:
 	FORCEINLINE const bool& IsNodeAccessible() const { return IsAccessible; }
+	FORCEINLINE bool IsNodeWaypoint() const { return IsWaypoint; }
+	FORCEINLINE void SetNodeWaypoint(const bool _isWaypoint) { IsWaypoint = _isWaypoint; }
 	FORCEINLINE const FVector& NodeLocation() const { return Location; }
+	FORCEINLINE int NodeIndex() const { return Index; }
+	FORCEINLINE void SetNodeIndex(const int _index) { Index = _index; }
 
 	FORCEINLINE const TArray<UNavigationNode*>& NodeNeighbors() const { return Neighbors; }
 
 	// Call when a Agent arrived at the Node
 	void PassedBy(AActor* _actor);
 
-#if WITH_EDITOR
 #pragma region Init
-	void InitializeNavigationNodeSimple(const FVector& _location, const FNavigationMeshSettings& _navSettings);
-	void InitializeNavigationNodeComplex(const FVector& _location, const FNavigationMeshSettings& _navSettings);
+	//	Location and accessibility come from the generation traces (FNavigationMeshGenerator)
+	void InitializeNavigationNode(const FVector& _location, const bool _isAccessible);
 	void AddNeighbor(UNavigationNode* _node);
 	void RemoveNeighbor(UNavigationNode* _node);
+	void ClearNeighbors();
 	bool NeighborExist(const UNavigationNode* _node) const;
-private:
-	void CheckLocationAccessibility(const FNavigationMeshSettings& _navSettings);
 #pragma endregion 
-	
-public:
+
+#if WITH_EDITOR
 	void DrawNavigationNodeDebug(const FColor& _nodeColor, const FColor& _lineColor, const float& _drawTime) const;
 #endif	
 };
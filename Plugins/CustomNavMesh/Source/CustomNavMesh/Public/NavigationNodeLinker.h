@@ -60,6 +60,12 @@ protected:
 public:	
 	ANavigationNodeLinker();
 
+	FORCEINLINE ANavigationMesh* GetNavigationMesh() const { return NavigationMesh; }
+	FORCEINLINE UNavigationNode* GetNodeLeft() const { return NodeLeft; }
+	FORCEINLINE UNavigationNode* GetNodeRight() const { return NodeRight; }
+	//	Add the edges of the link again, after the Nodes around it were patched (the graph is not compiled)
+	void RestoreNodeLink();
+
 protected:
 	virtual void BeginPlay() override;
 	virtual void Tick(float DeltaSeconds) override;
@@ -71,13 +77,13 @@ protected:
 
 	UFUNCTION() void OnNodePassedBy(UNavigationNode* _node, AActor* _actor);
 	UFUNCTION(BlueprintImplementableEvent) void OnLinkedNodeReached(AActor* _agent, const FVector& _destination);
+	void InitNeighbors(const ENodeLink& _link) const;
 	
 #if WITH_EDITOR
 	#pragma region Init
 	UFUNCTION(CallInEditor, Category = "Navigation Node Linker") void InitNodeLink();
 	UFUNCTION(CallInEditor, Category = "Navigation Node Linker") void ClearNodeLink();
 	void RemoveNeighbors(const ENodeLink& _link) const;
-	void InitNeighbors(const ENodeLink& _link) const;
 	#pragma endregion
 
 	#pragma region Edit
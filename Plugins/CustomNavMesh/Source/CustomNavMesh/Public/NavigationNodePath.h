@@ -2,20 +2,22 @@
 
 #include "NavigationNodePath.generated.h"
 
-class UNavigationNode;
-
 USTRUCT()
 struct FNavigationNodePath
 {
 	GENERATED_BODY()
 		
+	//	Node indices in the Navigation Mesh
+	UPROPERTY(VisibleAnywhere)
+	TArray<int> NodePath = { };
+	//	Location of each Node of the path (path stays valid if the Navigation Mesh graph is recompiled)
 	UPROPERTY(VisibleAnywhere)
-	TArray<UNavigationNode*> NodePath = { };
+	TArray<FVector> NodeLocations = { };
 
 	UPROPERTY(VisibleAnywhere)
-	UNavigationNode* CurrentNode = nullptr; 
+	int CurrentNode = INDEX_NONE; 
 	UPROPERTY(VisibleAnywhere)
-	UNavigationNode* PreviousNode = nullptr; 
+	int PreviousNode = INDEX_NONE; 
 	UPROPERTY(VisibleAnywhere)
 	bool PathCompleted = false;
 	UPROPERTY()
@@ -25,17 +27,19 @@ struct FNavigationNodePath
 	{
 		NextNode();
 	}
-	FNavigationNodePath(const TArray<UNavigationNode*>& _path) : NodePath(_path)
+	FNavigationNodePath(const TArray<int>& _path, const TArray<FVector>& _locations) : NodePath(_path), NodeLocations(_locations)
 	{
 		NextNode();
 	}
+
+	FORCEINLINE const FVector& CurrentNodeLocation() const { return NodeLocations[PathIndex]; }
 	
 	/**
 	 * Increment Path index and update Path 
 	 *
-	 * @return		New Current node (nullptr if path is completed)
+	 * @return		New Current node (INDEX_NONE if path is completed)
 	 */
-	UNavigationNode* NextNode()
+	int NextNode()
 	{
 		PathIndex++;
 		
@@ -47,18 +51,41 @@ struct FNavigationNodePath
 		else
 		{
 			PreviousNode = CurrentNode;
-			CurrentNode = nullptr;
+			CurrentNode = INDEX_NONE;
 			PathCompleted = true;
 		}
 
 		return CurrentNode;
 	}
 
+	//	Replace the path with the single Node to reach next (path given one Node at a time, e.g. by a flow field)
+	void SetNextNode(const int _node, const FVector& _location)
+	{
+		PreviousNode = CurrentNode;
+		CurrentNode = _node;
+		PathCompleted = _node == INDEX_NONE;
+		NodePath.Reset();
+		NodeLocations.Reset();
+		NodePath.Add(_node);
+		NodeLocations.Add(_location);
+		PathIndex = 0;
+	}
+
 	//Update the current path with a new one
 	void UpdatePath(FNavigationNodePath _newPath)
 	{	
+		const int _currentIndex = _newPath.NodePath.Find(CurrentNode);	//	New path can start from a Node already passed (path computed asynchronously)
+		if (_currentIndex > 0)
+		{
+			_newPath.NodePath.RemoveAt(0, _currentIndex);
+			_newPath.NodeLocations.RemoveAt(0, _currentIndex);
+		}
+
+		const FVector _currentLocation = CurrentNodeLocation();
 		NodePath = { CurrentNode };	//	Reset Node path with only the Current (Agent will at least keep moving to is Current target node)
+		NodeLocations = { _currentLocation };
 		PathIndex = 0;				//	Reset Path Index
 		NodePath.Append(_newPath.NodePath);	//Add news nodes to path 
+		NodeLocations.Append(_newPath.NodeLocations);
 	}
 };
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "NavigationGraph.h"
+
+//	Volume blocking the Nodes inside it (Box : half extent, Cylinder : X = radius, Z = half height)
+struct FNavigationObstacleShape
+{
+	FTransform Transform = FTransform::Identity;
+	FVector Extent = FVector(50);
+	bool IsCylinder = false;
+
+	FNavigationObstacleShape() { }
+	FNavigationObstacleShape(const FTransform& _transform, const FVector& _extent, const bool _isCylinder) :
+	Transform(_transform),
+	Extent(_extent),
+	IsCylinder(_isCylinder)
+	{ }
+
+	FORCEINLINE bool Contains(const FVector& _worldLocation) const
+	{
+		const FVector& _local = Transform.InverseTransformPosition(_worldLocation);
+		if (FMath::Abs(_local.Z) > Extent.Z) return false;
+		if (IsCylinder) return _local.X * _local.X + _local.Y * _local.Y <= Extent.X * Extent.X;
+		return FMath::Abs(_local.X) <= Extent.X && FMath::Abs(_local.Y) <= Extent.Y;
+	}
+	FORCEINLINE FBox GetBounds() const
+	{
+		const FVector _extent = IsCylinder ? FVector(Extent.X, Extent.X, Extent.Z) : Extent;
+		return FBox(-_extent, _extent).TransformBy(Transform);
+	}
+};
+
+/**
+ * Runtime obstacles of a Navigation Mesh stamped on its graph : a Node is blocked while at least one obstacle contains it.
+ * Nodes are found with the spatial index of the graph (no physics query), moving an obstacle only touches the Nodes it leaves and enters.
+ * Version is bumped each time a Node is blocked or freed, searches read a snapshot of the blocked Nodes (GetSnapshot). Game thread only.
+ */
+class CUSTOMNAVMESH_API FNavigationObstacleSet
+{
+	struct FObstacle
+	{
+		FNavigationObstacleShape Shape;
+		TArray<int> Nodes = { };		//	Nodes stamped by the obstacle
+	};
+
+	FNavigationGraphPtr Graph = nullptr;
+	TSparseArray<FObstacle> Obstacles;
+	TArray<uint16> BlockCount = { };	//	Obstacles containing each Node
+	TBitArray<> Blocked;
+	int BlockedCount = 0;
+	uint32 Version = 0;
+
+	FNavigationBlockedNodesPtr Snapshot = nullptr;
+	TArray<int> Candidates = { };		//	Scratch of the spatial queries
+
+public:
+	FORCEINLINE uint32 GetVersion() const { return Version; }
+	FORCEINLINE int ObstacleCount() const { return Obstacles.Num(); }
+	FORCEINLINE int BlockedNodeCount() const { return BlockedCount; }
+	FORCEINLINE bool IsBlocked(const int _node) const { return Blocked.IsValidIndex(_node) && Blocked[_node]; }
+
+	//	Register an obstacle and block the Nodes inside it, returns its id
+	int Add(const FNavigationObstacleShape& _shape);
+	//	Move or resize an obstacle : Nodes it left are freed, Nodes it entered are blocked
+	void Update(const int _id, const FNavigationObstacleShape& _shape);
+	void Remove(const int _id);
+	//	Stamp all the obstacles again on a newly compiled graph
+	void SetGraph(const FNavigationGraphPtr& _graph);
+
+	//	Blocked Nodes of the current version, nullptr if no Node is blocked
+	FNavigationBlockedNodesPtr GetSnapshot();
+
+private:
+	void Stamp(FObstacle& _obstacle);
+	//	Remove one stamp from each of the Nodes
+	void Unstamp(const TArray<int>& _nodes);
+};
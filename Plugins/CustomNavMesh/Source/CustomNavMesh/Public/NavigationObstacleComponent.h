@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+
+#include "NavigationObstacle.h"
+
+#include "NavigationObstacleComponent.generated.h"
+
+class ANavigationMesh;
+
+UENUM()
+enum ENavigationObstacleShape
+{
+	ObstacleBox UMETA(DisplayName = "Box"),
+	ObstacleCylinder UMETA(DisplayName = "Cylinder")
+};
+
+/**
+ * Blocks the Nodes of a Navigation Mesh inside its volume while enabled (doors, vehicles, destructibles...).
+ * The volume follows the component : Nodes are blocked and freed again when it moves, without any trace.
+ */
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class CUSTOMNAVMESH_API UNavigationObstacleComponent : public USceneComponent
+{
+	GENERATED_BODY()
+
+	//	Navigation Mesh to block (first Navigation Mesh of the level if not set)
+	UPROPERTY(EditAnywhere, Category = "Navigation Obstacle | System")
+	ANavigationMesh* NavigationMesh = nullptr;
+	UPROPERTY(EditAnywhere, Category = "Navigation Obstacle | Shape")
+	TEnumAsByte<ENavigationObstacleShape> Shape = ENavigationObstacleShape::ObstacleBox;
+	UPROPERTY(EditAnywhere, Category = "Navigation Obstacle | Shape", meta = (ClampMin = "0", EditCondition = "Shape == ENavigationObstacleShape::ObstacleBox"))
+	FVector BoxExtent = FVector(50, 50, 100);
+	UPROPERTY(EditAnywhere, Category = "Navigation Obstacle | Shape", meta = (ClampMin = "0", EditCondition = "Shape == ENavigationObstacleShape::ObstacleCylinder"))
+	float CylinderRadius = 50;
+	UPROPERTY(EditAnywhere, Category = "Navigation Obstacle | Shape", meta = (ClampMin = "0", EditCondition = "Shape == ENavigationObstacleShape::ObstacleCylinder"))
+	float CylinderHalfHeight = 100;
+	//	Moves smaller than this are ignored (Nodes are only stamped again once the obstacle moved far enough)
+	UPROPERTY(EditAnywhere, Category = "Navigation Obstacle | Shape", meta = (ClampMin = "0"))
+	float UpdateDistance = 10;
+	UPROPERTY(EditAnywhere, Category = "Navigation Obstacle | Default Values")
+	bool ObstacleEnable = true;
+
+#if WITH_EDITORONLY_DATA
+	UPROPERTY(EditAnywhere, Category = "Navigation Obstacle | Debug")
+	bool Debug = false;
+	UPROPERTY(EditAnywhere, Category = "Navigation Obstacle | Debug")
+	FColor ObstacleDebugColor = FColor::Red;
+#endif
+
+	//	Id of the obstacle in the Navigation Mesh (INDEX_NONE if not registered)
+	int ObstacleId = INDEX_NONE;
+	FTransform StampedTransform = FTransform::Identity;
+
+public:
+	UNavigationObstacleComponent();
+
+	UFUNCTION(BlueprintCallable) void SetObstacleEnable(const bool _enable);
+	//	Set the extent of the box shape (half size)
+	UFUNCTION(BlueprintCallable) void SetBoxExtent(const FVector& _extent);
+	UFUNCTION(BlueprintCallable) void SetCylinderSize(const float _radius, const float _halfHeight);
+
+	FORCEINLINE bool IsObstacleRegistered() const { return ObstacleId != INDEX_NONE; }
+
+private:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport) override;
+#if WITH_EDITOR
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+#endif
+
+	FNavigationObstacleShape GetObstacleShape() const;
+	void RegisterObstacle();
+	void UnregisterObstacle();
+	//	Stamp the Nodes again if the shape moved beyond UpdateDistance (or always if _force)
+	void UpdateObstacle(const bool _force);
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Bounded LRU cache of Node paths keyed by (Start Node, End Node, search mode).
+ * Entries belong to a navigation version and the whole cache is dropped when the version changes.
+ * A cached optimal path going through the requested Start Node to the same End Node also answers the request (its suffix is a shortest path too).
+ * Paths of non optimal searches (hierarchical, approximate heuristic) only answer the exact same query.
+ */
+class CUSTOMNAVMESH_API FNavigationPathCache
+{
+	struct FEntry
+	{
+		int StartNode = INDEX_NONE;
+		int EndNode = INDEX_NONE;
+		uint8 Mode = 0;
+		bool IsOptimal = false;				//	Shortest path : its sub paths are shortest paths too
+		TArray<int> Path = { };
+		int Previous = INDEX_NONE;			//	LRU list links (toward most recently used)
+		int Next = INDEX_NONE;				//	(toward least recently used)
+	};
+
+	TArray<FEntry> Entries = { };
+	using FKey = TTuple<int, int, uint8>;	//	Start Node, End Node, search mode
+	TMap<FKey, int> EntryByKey = { };
+	TMultiMap<int, int> EntriesByEnd = { };	//	Optimal entries by End Node, for sub path lookups
+	int MostRecent = INDEX_NONE;
+	int LeastRecent = INDEX_NONE;
+	int Capacity = 256;
+	uint32 Version = 0;
+
+	int Hits = 0;
+	int SubPathHits = 0;
+	int Misses = 0;
+
+public:
+	FORCEINLINE int CacheHits() const { return Hits; }
+	FORCEINLINE int CacheSubPathHits() const { return SubPathHits; }
+	FORCEINLINE int CacheMisses() const { return Misses; }
+	FORCEINLINE int Num() const { return EntryByKey.Num(); }
+
+	//	Max number of paths (0 disables the cache)
+	void SetCapacity(const int _capacity);
+	void Empty();
+
+	//	Path from _startNode to _endNode computed with the navigation _version by the search _mode, or sub path of an optimal one if _isOptimal
+	bool Find(const uint32 _version, const uint8 _mode, const bool _isOptimal, const int _startNode, const int _endNode, TArray<int>& _outPath);
+	//	Store a path (first Node to last Node) computed with the navigation _version by the search _mode
+	void Add(const uint32 _version, const uint8 _mode, const bool _isOptimal, const TArray<int>& _path);
+
+private:
+	static FORCEINLINE FKey MakeKey(const int _startNode, const int _endNode, const uint8 _mode) { return FKey(_startNode, _endNode, _mode); }
+
+	//	Drop the cache if it was filled with another navigation version
+	void CheckVersion(const uint32 _version);
+	void Unlink(const int _entry);
+	void LinkFront(const int _entry);
+	void Touch(const int _entry);
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "NavigationGraph.h"
+#include "NavigationNodePath.h"
+
+/**
+ * String pulling of the Node paths : a Node is removed when the Agent can walk straight from the last kept Node to the Node after it.
+ * Line of sight comes from the graph (FNavigationRaycast), results are memoized until the navigation version changes.
+ * Nodes flagged NodeFlagWaypoint (Node Linkers) are always kept. Game thread only.
+ */
+class CUSTOMNAVMESH_API FNavigationPathSmoother
+{
+	TMap<uint64, bool> Visibility = { };
+	int Capacity = 4096;
+	uint32 Version = 0;
+
+	int Tests = 0;
+	int CachedTests = 0;
+
+public:
+	FORCEINLINE int VisibilityTests() const { return Tests; }
+	FORCEINLINE int CachedVisibilityTests() const { return CachedTests; }
+	FORCEINLINE int Num() const { return Visibility.Num(); }
+
+	//	Max number of memoized Node pairs (0 disables the memo)
+	void SetCapacity(const int _capacity);
+	void Empty();
+
+	/**
+	 * Remove the Nodes of the path the Agent doesn't need to reach (path must come from _graph, it is left untouched otherwise)
+	 *
+	 * @param _version		Navigation version of _graph and _blocked, the memo is dropped when it changes
+	 */
+	void SmoothPath(const FNavigationGraph& _graph, const uint32 _version, const FNavigationBlockedNodes* _blocked, FNavigationNodePath& _path);
+
+private:
+	bool IsVisible(const FNavigationGraph& _graph, const int _fromNode, const int _toNode, const FNavigationBlockedNodes* _blocked);
+};
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Containers/Queue.h"
+
+#include "NavigationGraph.h"
+#include "NavigationNodePath.h"
+#include "NavigationSearch.h"
+
+#include "NavigationPathSubsystem.generated.h"
+
+DECLARE_DELEGATE_TwoParams(FOnNavigationPathQueryCompleted, const bool /*_success*/, const FNavigationNodePath& /*_path*/);
+
+USTRUCT()
+struct FNavigationPathQueryHandle
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	uint32 Id = 0;
+
+	FORCEINLINE bool IsValid() const { return Id != 0; }
+	FORCEINLINE void Invalidate() { Id = 0; }
+};
+
+//	Path request shared between the game thread and the worker running it
+struct FNavigationPathQuery
+{
+	uint32 Id = 0;
+	FNavigationPathRequest Request;					//	Immutable snapshots : the mesh can recompile while the query runs
+	const UObject* Owner = nullptr;					//	Only used as a key for supersession, never dereferenced
+	FOnNavigationPathQueryCompleted OnCompleted;
+
+	std::atomic<bool> Cancelled { false };
+	bool Success = false;
+	FNavigationNodePath Path = FNavigationNodePath();
+
+	//	Time sliced queries (game thread, steppable requests only)
+	TUniquePtr<FNavigationSearch> Search = nullptr;
+	uint8 Priority = 0;
+	uint64 LastServedFrame = 0;
+};
+typedef TSharedPtr<FNavigationPathQuery, ESPMode::ThreadSafe> FNavigationPathQueryPtr;
+
+//	Data used by the worker threads, kept alive by the workers if the subsystem is destroyed before they finish
+struct FNavigationPathQueryWorkers
+{
+	TQueue<FNavigationPathQueryPtr, EQueueMode::Mpsc> Completed;
+
+	TUniquePtr<FNavigationSearch> AcquireSearch();
+	void ReleaseSearch(TUniquePtr<FNavigationSearch> _search);
+
+private:
+	FCriticalSection SearchPoolLock;
+	TArray<TUniquePtr<FNavigationSearch>> SearchPool = { };		//	Reused to avoid reallocating per Node arrays for every query
+};
+
+/**
+ * Runs path queries on worker threads against an immutable graph snapshot and delivers results on the game thread.
+ * A new query from the same owner cancels (supersedes) the previous one.
+ */
+UCLASS()
+class CUSTOMNAVMESH_API UNavigationPathSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	TSharedPtr<FNavigationPathQueryWorkers, ESPMode::ThreadSafe> Workers = nullptr;
+	TMap<uint32, FNavigationPathQueryPtr> PendingQueries = { };
+	TMap<const UObject*, uint32> OwnerQueries = { };			//	Last query of each owner
+	uint32 NextQueryId = 1;
+
+	//	Queries stepped on the game thread within the frame budget
+	TArray<FNavigationPathQueryPtr> TimeSlicedQueries = { };
+	double FrameBudgetSeconds = 0.001;
+	double LastFrameSearchSeconds = 0;
+
+public:
+	/**
+	 * Queue a path query, _onCompleted is called on the game thread (never called if the query is cancelled or superseded)
+	 *
+	 * @param _owner	Requester, a new query from the same owner cancels its previous one (can be nullptr)
+	 * @return			Handle to cancel the query
+	 */
+	FNavigationPathQueryHandle RequestPath(const FNavigationPathRequest& _request, const UObject* _owner, const FOnNavigationPathQueryCompleted& _onCompleted);
+	/**
+	 * Queue a path query computed on the game thread, a bit every frame, within the frame budget shared by all time sliced queries
+	 *
+	 * Requests which can't be stepped (hierarchical, Jump Point, bidirectional) are run on a worker thread like RequestPath instead :
+	 * they would run to completion in one slice, over the budget. Their priority is ignored and they complete as soon as the worker is done.
+	 *
+	 * @param _priority		Higher priority queries are stepped first and get a larger share of the budget
+	 */
+	FNavigationPathQueryHandle RequestPathTimeSliced(const FNavigationPathRequest& _request, const UObject* _owner, const uint8 _priority, const FOnNavigationPathQueryCompleted& _onCompleted);
+	void CancelQuery(const FNavigationPathQueryHandle& _handle);
+	bool IsQueryPending(const FNavigationPathQueryHandle& _handle) const;
+
+	FORCEINLINE int PendingQueryCount() const { return PendingQueries.Num(); }
+	FORCEINLINE double LastFrameSearchTime() const { return LastFrameSearchSeconds; }
+
+	//	Max game thread time spent on time sliced queries per frame
+	UFUNCTION(BlueprintCallable) void SetFrameBudget(const float _milliseconds);
+
+private:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	FNavigationPathQueryPtr CreateQuery(const FNavigationPathRequest& _request, const UObject* _owner, const FOnNavigationPathQueryCompleted& _onCompleted);
+	//	Run the query at once on a worker thread, the result is delivered by ProcessCompletedQueries
+	void RunQueryAsync(const FNavigationPathQueryPtr& _query);
+
+	//	Deliver finished queries to their requester
+	void ProcessCompletedQueries();
+	//	Step time sliced queries until the frame budget is spent
+	void ProcessTimeSlicedQueries();
+	void ForgetQuery(const FNavigationPathQuery& _query);
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "NavigationGraph.h"
+
+//	Result of a FNavigationRaycast::Raycast
+struct FNavigationRaycastHit
+{
+	//	Stopped before the end of the segment
+	bool IsHit = false;
+	//	Part of the segment travelled before the stop (1 if not hit)
+	float Fraction = 1;
+	//	Last Node reached
+	int LastNode = INDEX_NONE;
+	//	Node that stopped the ray (inaccessible, blocked or not linked to LastNode), INDEX_NONE if the ray left the mesh
+	int HitNode = INDEX_NONE;
+	//	Point of the segment where the ray stopped (end of the segment if not hit)
+	FVector Location = FVector::ZeroVector;
+};
+
+/**
+ * Line of sight tests over a compiled graph, without any physics query : a segment is walkable if a chain of neighbor Nodes follows it (XY).
+ * Simple grids are traversed cell by cell (DDA), each cell crossed must be an accessible Node linked to the previous one.
+ * Complex grids are walked from neighbor to neighbor, each step must progress along the segment and stay close to it (3/4 of the grid gap).
+ * Only reads the graph and the blocked Nodes snapshot given : safe on any thread as long as the caller keeps them alive.
+ */
+struct CUSTOMNAVMESH_API FNavigationRaycast
+{
+	/**
+	 * Walk the segment from the Node under _start toward _end
+	 *
+	 * @param _blocked		Nodes blocked by the obstacles (can be nullptr), a blocked Node stops the ray
+	 * @return				true if _end is reached
+	 */
+	static bool Raycast(const FNavigationGraph& _graph, const FVector& _start, const FVector& _end, const FNavigationBlockedNodes* _blocked, FNavigationRaycastHit& _outHit);
+	//	Can an Agent walk in a straight line from _fromNode to _toNode
+	static bool IsWalkable(const FNavigationGraph& _graph, const int _fromNode, const int _toNode, const FNavigationBlockedNodes* _blocked);
+};
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "NavigationGraph.h"
+
+enum class ENavigationReplanResult : uint8
+{
+	Reused,			//	Nothing relevant changed : the previous path was reused without any search
+	Repaired,		//	Previous search state was repaired
+	Planned,		//	Search started from scratch
+	Failed
+};
+
+/**
+ * Incremental planner (LPA* / Moving Target D* Lite) keeping its search state between two plans of the same Agent.
+ * The search tree is rooted at the start Node : a moved goal only continues the search (key modifier), accessibility changes
+ * only update the Nodes around the changed ones, and a moved start keeps the part of the tree under the new start.
+ * State is sparse (only the Nodes the search reached) so each Agent can own one. Game thread only, not shared.
+ */
+class CUSTOMNAVMESH_API FNavigationReplanner
+{
+	struct FNodeState
+	{
+		int Node = INDEX_NONE;
+		float G = UE_MAX_FLT;
+		float Rhs = UE_MAX_FLT;			//	One step lookahead of G (best predecessor G + edge cost)
+		int Parent = INDEX_NONE;		//	Predecessor giving Rhs
+		float Key1 = 0;					//	Key of the Node in the open list (valid if Open)
+		float Key2 = 0;
+		bool Open = false;
+	};
+	struct FOpenEntry
+	{
+		float Key1 = 0;
+		float Key2 = 0;
+		int Slot = INDEX_NONE;
+	};
+
+	FNavigationGraphPtr Graph = nullptr;
+	FNavigationBlockedNodesPtr BlockedNodes = nullptr;	//	Obstacles of the previous plan
+	int StartNode = INDEX_NONE;
+	int GoalNode = INDEX_NONE;
+	float KeyModifier = 0;				//	Sum of the goal moves, keeps the keys in the open list lower bounds
+
+	TMap<int, int> NodeSlots = { };		//	Node -> index in States
+	TArray<FNodeState> States = { };
+	TArray<FOpenEntry> OpenList = { };	//	Binary heap, entries of Nodes removed or re-keyed since are skipped when popped
+	int OpenCount = 0;
+
+	TArray<int> LastPath = { };
+	int Expansions = 0;
+
+public:
+	FORCEINLINE int LastExpansions() const { return Expansions; }
+	FORCEINLINE int StateCount() const { return States.Num(); }
+
+	/**
+	 * Path from _startNode to _goalNode on _graph, reusing the previous plan as much as possible
+	 *
+	 * @param _graph		Snapshot to plan on, a newer version of the previous graph is applied as a change set
+	 * @param _outPath		Goes from _startNode to _goalNode (both included), empty if failed
+	 * @param _blocked		Nodes blocked by the obstacles, only the Nodes blocked or freed since the previous plan are updated
+	 */
+	ENavigationReplanResult Replan(const FNavigationGraphPtr& _graph, const int _startNode, const int _goalNode, TArray<int>& _outPath, const FNavigationBlockedNodesPtr& _blocked = nullptr);
+	//	Forget the search state
+	void Reset();
+
+private:
+	FORCEINLINE float Heuristic(const int _node) const { return FVector::Dist(Graph->NodeLocation(_node), Graph->NodeLocation(GoalNode)); }
+	FORCEINLINE float NodeG(const int _node) const { const int* _slot = NodeSlots.Find(_node); return _slot ? States[*_slot].G : UE_MAX_FLT; }
+	FORCEINLINE static bool KeyLess(const float _a1, const float _a2, const float _b1, const float _b2) { return _a1 < _b1 || (_a1 == _b1 && _a2 < _b2); }
+	int GetSlot(const int _node);
+
+	void Initialize(const int _startNode, const int _goalNode);
+	//	Update the Nodes around the Nodes changed between the current graph and _graph (false if _graph is not the next version)
+	bool ApplyGraphChanges(const FNavigationGraphPtr& _graph);
+	//	Update the Nodes around the Nodes blocked or freed between the previous obstacles and _blocked
+	void ApplyBlockedChanges(const FNavigationBlockedNodesPtr& _blocked);
+	FORCEINLINE bool IsBlocked(const int _node) const { return BlockedNodes && BlockedNodes->IsBlocked(_node); }
+	//	Keep the part of the search tree under _startNode and make it the root (false if _startNode was not reached)
+	bool Reroot(const int _startNode);
+
+	void ComputeKey(const FNodeState& _state, float& _key1, float& _key2) const;
+	//	Recompute Rhs from the predecessors and queue the Node if inconsistent
+	void UpdateNode(const int _node);
+	void Queue(const int _slot);
+	void Unqueue(const int _slot);
+	//	Drop the stale entries on top of the open list
+	void CleanOpenListTop();
+	void ComputeShortestPath();
+	bool ExtractPath(TArray<int>& _outPath) const;
+};
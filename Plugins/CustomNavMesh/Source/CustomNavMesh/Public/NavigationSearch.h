@@ -0,0 +1,166 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "NavigationGraph.h"
+#include "NavigationHierarchy.h"
+#include "NavigationJumpPointSearch.h"
+
+#include <atomic>
+
+/**
+ * Indexed binary min-heap over dense node indices.
+ * Keeps the heap slot of every node so a queued node can have its priority decreased in O(log n).
+ */
+class CUSTOMNAVMESH_API FNavigationNodeHeap
+{
+	TArray<int> Heap = { };			//	Node index stored in each heap slot
+	TArray<float> Keys = { };		//	Priority of each heap slot
+	TArray<int> HeapIndex = { };	//	Heap slot of each node (INDEX_NONE if the node is not queued)
+
+public:
+	FORCEINLINE bool IsEmpty() const { return Heap.IsEmpty(); }
+	FORCEINLINE int Num() const { return Heap.Num(); }
+	FORCEINLINE bool Contains(const int _node) const { return HeapIndex.IsValidIndex(_node) && HeapIndex[_node] != INDEX_NONE; }
+	FORCEINLINE int Top() const { return Heap[0]; }
+	FORCEINLINE float TopKey() const { return Keys[0]; }
+
+	//	Empty the heap and make room for _nodeCount node indices (only clears the slots still in use)
+	void Reset(const int _nodeCount);
+	//	Add the node, or decrease its priority if it is already queued with a higher one
+	void Push(const int _node, const float _key);
+	//	Remove and return the node with the lowest priority
+	int Pop();
+	//	Remove the node if queued
+	void Remove(const int _node);
+
+private:
+	void SiftUp(int _slot);
+	void SiftDown(int _slot);
+	void Swap(const int _slotA, const int _slotB);
+};
+
+/**
+ * Flat per-node search data (Cost / Parent / Closed) indexed by node index.
+ * Entries are lazily invalidated with a query stamp so starting a new query never clears the arrays.
+ */
+struct CUSTOMNAVMESH_API FNavigationSearchState
+{
+	TArray<float> Cost = { };
+	TArray<int> Parent = { };
+	TArray<uint32> Stamp = { };		//	Query the entry belongs to (stale entries are treated as unvisited)
+	TArray<bool> Closed = { };
+	uint32 QueryStamp = 0;
+
+	//	Start a new query on a graph of _nodeCount nodes
+	void Reset(const int _nodeCount);
+
+	FORCEINLINE bool IsVisited(const int _node) const { return Stamp[_node] == QueryStamp; }
+	FORCEINLINE bool IsClosed(const int _node) const { return IsVisited(_node) && Closed[_node]; }
+	FORCEINLINE float NodeCost(const int _node) const { return IsVisited(_node) ? Cost[_node] : UE_MAX_FLT; }
+
+	//	Make the entry valid for the current query and reset its values
+	void Visit(const int _node);
+};
+
+enum class ENavigationSearchStatus : uint8
+{
+	InProgress,
+	Succeeded,
+	Failed
+};
+
+//	Everything needed to run a path query, snapshots are kept alive by the request
+struct FNavigationPathRequest
+{
+	FNavigationGraphPtr Graph = nullptr;
+	FNavigationHierarchyPtr Hierarchy = nullptr;		//	Hierarchical search only
+	FNavigationJumpPointGridPtr JumpPointGrid = nullptr;	//	Jump Point search only
+	FNavigationBlockedNodesPtr BlockedNodes = nullptr;		//	Nodes blocked by the obstacles when the request was made (none if nullptr)
+	int StartNode = INDEX_NONE;
+	int EndNode = INDEX_NONE;
+	TEnumAsByte<ENavigationSearchMode> Mode = ENavigationSearchMode::SearchAStar;
+
+	FORCEINLINE bool IsValid() const { return Graph.IsValid(); }
+	//	Only plain A* can be stepped, other modes run at once
+	FORCEINLINE bool IsSteppable() const
+	{
+		return !(Mode == ENavigationSearchMode::SearchHierarchical && Hierarchy) && !(Mode == ENavigationSearchMode::SearchJumpPoint && JumpPointGrid)
+			&& Mode != ENavigationSearchMode::SearchBidirectional;
+	}
+};
+
+/**
+ * Resumable A* search over a compiled Navigation Graph.
+ * A search can be run at once (FindPath) or stepped for a number of expansions / a time budget and continued later (Begin / Step).
+ * Guided by the distance to the End Node, and by the landmark bounds (ALT) when the graph has landmarks.
+ * Owns its search data : reuse one instance per caller, never share it between threads.
+ */
+class CUSTOMNAVMESH_API FNavigationSearch
+{
+	FNavigationSearchState State;
+	FNavigationNodeHeap OpenList;
+	//	Search from the End Node of the bidirectional search (allocated on first use)
+	FNavigationSearchState BackwardState;
+	FNavigationNodeHeap BackwardOpenList;
+
+	const FNavigationGraph* Graph = nullptr;	//	Caller keeps the graph alive until the search is done
+	const FNavigationBlockedNodes* BlockedNodes = nullptr;	//	Same for the blocked Nodes
+	int StartNode = INDEX_NONE;
+	int EndNode = INDEX_NONE;
+	int Expansions = 0;
+	ENavigationSearchStatus Status = ENavigationSearchStatus::Failed;
+
+	FVector EndLocation = FVector::ZeroVector;
+	const FNavigationLandmarks* Landmarks = nullptr;	//	Landmarks of the graph (nullptr if it has none)
+	const uint16* EndLandmarkFrom = nullptr;			//	Landmark rows of the End Node
+	const uint16* EndLandmarkTo = nullptr;
+
+public:
+	FORCEINLINE ENavigationSearchStatus SearchStatus() const { return Status; }
+	FORCEINLINE int SearchExpansions() const { return Expansions; }
+
+	//	Find the cheapest path between two Nodes, _outPath goes from _startNode to _endNode (both included)
+	//	_cancelled is polled during the search (a cancelled search fails), the _blocked Nodes are never entered
+	bool FindPath(const FNavigationGraph& _graph, const int _startNode, const int _endNode, TArray<int>& _outPath, const std::atomic<bool>* _cancelled = nullptr, const FNavigationBlockedNodes* _blocked = nullptr);
+	/**
+	 * Same as FindPath, searching from both ends at once until the two searches meet (always run at once, landmarks are not used)
+	 * Each search expands its Nodes by cost + average of the distance estimates : the shortest path is known as soon as
+	 * the lowest keys of both open lists add up to the best meeting cost, about half of the Nodes of A* are expanded on open meshes.
+	 * One way edges are followed backward with the reverse adjacency of the graph.
+	 */
+	bool FindPathBidirectional(const FNavigationGraph& _graph, const int _startNode, const int _endNode, TArray<int>& _outPath, const std::atomic<bool>* _cancelled = nullptr, const FNavigationBlockedNodes* _blocked = nullptr);
+	//	Run the request with the search of its mode (plain A* if the mode data is missing)
+	bool FindPath(const FNavigationPathRequest& _request, TArray<int>& _outPath, const std::atomic<bool>* _cancelled = nullptr);
+
+	//	Start a search without expanding any Node (the _blocked Nodes are never entered)
+	ENavigationSearchStatus Begin(const FNavigationGraph& _graph, const int _startNode, const int _endNode, const FNavigationBlockedNodes* _blocked = nullptr);
+	/**
+	 * Continue the search
+	 *
+	 * @param _maxExpansions	Max Nodes expanded by this step
+	 * @param _maxSeconds		Max time spent by this step (0 = no limit), checked every few expansions
+	 * @return					Search status after the step
+	 */
+	ENavigationSearchStatus Step(const int _maxExpansions, const double _maxSeconds = 0);
+	//	Stop the search (status becomes Failed)
+	void Abort();
+
+	//	Path found by a Succeeded search
+	void GetPath(TArray<int>& _outPath) const;
+	//	A Node of the path after the start one is blocked
+	static bool IsPathBlocked(const TArray<int>& _path, const FNavigationBlockedNodes& _blocked);
+
+	//	Per Node arrays of the search, used as scratch memory by the other searches (hierarchy...) between two A* queries
+	FORCEINLINE FNavigationSearchState& ScratchState() { return State; }
+	FORCEINLINE const FNavigationSearchState& ScratchState() const { return State; }
+	FORCEINLINE FNavigationNodeHeap& ScratchOpenList() { return OpenList; }
+
+private:
+	//	Lower bound of the cost from the Node to the End Node
+	FORCEINLINE float EstimateCost(const int _node) const
+	{
+		const float _distance = FVector::Dist(Graph->NodeLocation(_node), EndLocation);
+		return Landmarks ? FMath::Max(_distance, Landmarks->LowerBound(_node, EndLandmarkFrom, EndLandmarkTo)) : _distance;
+	}
+};
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "NavigationMeshGenerator.h"
+
+/**
+ * Navigation data of one tile of a tiled Navigation Mesh : Node samples and the edges between them (indices local to the tile).
+ * Kept apart from the Nodes so a tile can be generated, saved, loaded and evicted on its own, edges toward the other tiles are stitched on load.
+ */
+struct CUSTOMNAVMESH_API FNavigationTileData
+{
+	FIntPoint Coord = FIntPoint::ZeroValue;
+	FNavigationGridLayout Layout;
+	TArray<FNavigationGenerationSample> Samples = { };
+	TArray<int> NeighborOffsets = { };		//	Neighbors of sample i are in [NeighborOffsets[i], NeighborOffsets[i + 1])
+	TArray<int> Neighbors = { };
+
+	FORCEINLINE int SampleCount() const { return Samples.Num(); }
+	FORCEINLINE int NeighborBegin(const int _sample) const { return NeighborOffsets[_sample]; }
+	FORCEINLINE int NeighborEnd(const int _sample) const { return NeighborOffsets[_sample + 1]; }
+	//	Tile generated with this grid (false if the settings changed since)
+	FORCEINLINE bool MatchLayout(const FNavigationGridLayout& _layout) const
+	{
+		return Layout.Origin.Equals(_layout.Origin) && Layout.Gap == _layout.Gap && Layout.SizeX == _layout.SizeX && Layout.SizeY == _layout.SizeY && Layout.IsSimpleGrid == _layout.IsSimpleGrid;
+	}
+
+	//	Take the samples and neighbors of a completed generation
+	void MoveFromGenerator(FNavigationMeshGenerator& _generator);
+
+	//	False if the archive does not hold a tile of the current format (loading only)
+	bool Serialize(FArchive& _archive);
+	bool SaveToFile(const FString& _path);
+	bool LoadFromFile(const FString& _path);
+	//	File of the tile _coord of a Navigation Mesh under _root (Content for baked tiles, Saved for the ones generated at runtime)
+	static FString GetFilePath(const FString& _root, const FString& _meshName, const FIntPoint& _coord);
+};
+
+typedef TSharedPtr<FNavigationTileData, ESPMode::ThreadSafe> FNavigationTileDataPtr;
+
+/**
+ * Split of a Navigation Mesh grid in square tiles of TileSize cells (the last tiles of a line can be smaller).
+ * Tile (X, Y) holds the cells [X * TileSize, (X + 1) * TileSize) x [Y * TileSize, (Y + 1) * TileSize) of the grid.
+ */
+struct CUSTOMNAVMESH_API FNavigationTileGrid
+{
+	FVector Origin = FVector::ZeroVector;
+	float Gap = 1;
+	int SizeX = 0;				//	Cells of the whole grid
+	int SizeY = 0;
+	int TileSize = 1;			//	Cells per tile side
+
+	FNavigationTileGrid() { }
+	FNavigationTileGrid(const FVector& _origin, const float _gap, const int _sizeX, const int _sizeY, const int _tileSize) :
+	Origin(_origin),
+	Gap(_gap),
+	SizeX(_sizeX),
+	SizeY(_sizeY),
+	TileSize(FMath::Max(1, _tileSize))
+	{ }
+
+	FORCEINLINE int TileCountX() const { return FMath::DivideAndRoundUp(SizeX, TileSize); }
+	FORCEINLINE int TileCountY() const { return FMath::DivideAndRoundUp(SizeY, TileSize); }
+	FORCEINLINE bool IsValidTile(const FIntPoint& _coord) const { return _coord.X >= 0 && _coord.Y >= 0 && _coord.X < TileCountX() && _coord.Y < TileCountY(); }
+	FORCEINLINE FIntPoint TileAt(const FVector& _worldLocation) const
+	{
+		return FIntPoint(FMath::FloorToInt((_worldLocation.X - Origin.X) / (Gap * TileSize)), FMath::FloorToInt((_worldLocation.Y - Origin.Y) / (Gap * TileSize)));
+	}
+
+	//	Grid of the cells of the tile, used to generate it
+	FNavigationGridLayout TileLayout(const FIntPoint& _coord, const bool _isSimpleGrid) const;
+	//	XY bounds of the cell centers of the tile
+	FBox2D TileBounds(const FIntPoint& _coord) const;
+	//	Distance between the location and the closest cell of the tile (XY)
+	float TileDistance(const FIntPoint& _coord, const FVector& _worldLocation) const;
+};
+
+//	Range of ANavigationMesh::NavigationNodes : Nodes of a loaded tile, or slots left free by an evicted one
+struct FNavigationNodeRange
+{
+	int FirstNode = 0;
+	int NodeCount = 0;
+
+	FNavigationNodeRange() { }
+	FNavigationNodeRange(const int _firstNode, const int _nodeCount) :
+	FirstNode(_firstNode),
+	NodeCount(_nodeCount)
+	{ }
+
+	FORCEINLINE bool ContainsNode(const int _node) const { return _node >= FirstNode && _node < FirstNode + NodeCount; }
+};